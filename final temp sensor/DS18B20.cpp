@@ -2,6 +2,9 @@
 #include "DS1Wire.h"
 #include "mbed.h"
 #include <stdint.h>
+#include "OneWire/Utilities/temperature.h"
+
+using namespace OneWire;
 
 // Device byte commands over 1-wire serial
 enum COMMANDS { READ_ROM = 0x33, CONVERT = 0x44, READ_SCRATCHPAD = 0xBE,  SKIP_ROM = 0xCC };
@@ -27,7 +30,7 @@ extern DigitalInOut sensor;     // sensor pin
 static void inError() {
     while (1) {
         resetFailure = !resetFailure;
-        wait(0.2);
+        wait_ms(200);
     }
 }
 
@@ -45,8 +48,8 @@ void DoConversion() {
     }
 }
 
-uint32_t GetTemperature() {
-    uint32_t result = 0;
+int16_t GetTemperature() {
+    int16_t result = 0;
     if (Reset(sensor) != 0) {
         inError();
     } else {
@@ -56,7 +59,7 @@ uint32_t GetTemperature() {
         scratchpad.LSB = ReadByte(sensor);
         scratchpad.MSB = ReadByte(sensor);
         Reset(sensor);    // terminate read as we only want temperature
-        result = ((scratchpad.MSB << 8) | scratchpad.LSB);
+        result = (int16_t)((scratchpad.MSB << 8) | scratchpad.LSB);
     }
     return result;
 }
@@ -75,13 +78,15 @@ ROM_Code_t ReadROM() {
     return ROM_Code;
 }
 
-// temperature is store as 7.4 fixed point format (assuming 12 bit conversion)
+// temperature is stored as signed 12.4 fixed point format, 1/16 degree C
 void displayTemperature(Serial& s) {
     DoConversion();
-    uint32_t temp = GetTemperature();
-    float f = (temp & 0x0F) * 0.0625;    // calculate .4 part
-    f += (temp >> 4);    // add 7.0 part to it
-    s.printf("Temp is %2.1fC\n\r", f);    // display in 2.1 format
+    int16_t t = temperature::tenths(GetTemperature());
+    const char * sign = (t < 0) ? "-" : "";
+    if (t < 0) {
+        t = -t;
+    }
+    s.printf("Temp is %s%d.%dC\n\r", sign, t / 10, t % 10);    // display in 2.1 format
 }
 
 
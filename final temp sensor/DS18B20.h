@@ -16,9 +16,9 @@ typedef union {
 
 ROM_Code_t ReadROM() ;
 
-// temperature is store as 7.4 fixed point format (assuming 12 bit conversion)
+// temperature is stored as signed 12.4 fixed point format, 1/16 degree C
 void displayTemperature(Serial& s) ;
-uint32_t GetTemperature();
+int16_t GetTemperature();
 void DoConversion();
 
 #endif
\ No newline at end of file
@@ -0,0 +1,308 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+// Bus-time benchmark for the ROM commands, ROM iterators and slave drivers.
+//
+// Every operation is run against SimulatedOneWireMaster, which charges the
+// AN126 recommended slot timings to a virtual clock, and the host wait shims
+// charge driver delays to the same clock. Results are therefore bus time and
+// do not depend on the host. One JSON object is written per line to stdout:
+//
+//   {"benchmark":"RomCommands::OWMatchRom","calls":100,"failures":0,
+//    "bus_us":2680.00,"resets":1.00,"bytes":9.00,"bits":0.00,"slots":72.00}
+//
+// All values after "failures" are averages per call. Bytes and bits count
+// byte and single bit operations issued by the driver.
+//
+// Host build, from the OneWire directory (a single command line):
+//
+//   g++ -O2 -I . -I Benchmarks/HostShims -o bus_benchmark
+//       Benchmarks/BusBenchmark.cpp Benchmarks/HostShims/HostClock.cpp
+//       Masters/OneWireMaster.cpp Masters/Simulated/*.cpp
+//       Masters/Simulated/Devices/*.cpp RomId/*.cpp Utilities/crc.cpp
+//       Slaves/Sensors/DS18B20/DS18B20.cpp Slaves/Memory/DS2431/DS2431.cpp
+//       Slaves/Bridges/DS28E17/DS28E17.cpp
+//       Slaves/Authenticators/DS28E15_22_25/*.cpp
+
+#include <stdio.h>
+#include "Benchmarks/HostShims/HostClock.h"
+#include "Masters/Simulated/Simulated.h"
+#include "RomId/RomCommands.h"
+#include "RomId/RomIterator.h"
+#include "Slaves/Sensors/DS18B20/DS18B20.h"
+#include "Slaves/Memory/DS2431/DS2431.h"
+#include "Slaves/Bridges/DS28E17/DS28E17.h"
+#include "Slaves/Authenticators/DS28E15_22_25/DS28E15.h"
+#include "Utilities/crc.h"
+
+using namespace OneWire;
+
+static const unsigned int defaultCalls = 100;
+
+static RomId makeRomId(uint8_t familyCode, uint8_t serial)
+{
+    RomId romId;
+    romId.buffer.fill(0x00);
+    romId.familyCode() = familyCode;
+    romId.buffer[1] = serial;
+    romId.crc8() = crc::calculateCrc8(romId.buffer.data(), romId.buffer.size() - 1, 0x00);
+    return romId;
+}
+
+/// Multidrop bus with one of each modelled device and a separate singledrop bus.
+struct Fixture
+{
+    SimulatedOneWireMaster master;
+    SimulatedOneWireMaster singleMaster;
+    
+    SimulatedDS18B20 poweredSensor;
+    SimulatedDS18B20 parasiteSensor;
+    SimulatedDS2431 eeprom;
+    SimulatedDS2413 switchDevice;
+    SimulatedDS28E17 bridge;
+    SimulatedDS28E15 authenticator;
+    SimulatedDS2431 singleEeprom;
+    
+    MultidropRomIterator multidrop;
+    MultidropRomIteratorWithResume multidropResume;
+    SingledropRomIterator singledrop;
+    ForwardSearchRomIterator forwardSearch;
+    RomCommands::SearchState searchState;
+    
+    DS18B20 poweredSensorDriver;
+    DS18B20 parasiteSensorDriver;
+    DS2431 eepromDriver;
+    DS28E17 bridgeDriver;
+    DS28E15 authenticatorDriver;
+    
+    Fixture()
+        : master(hostClock()), singleMaster(hostClock()),
+          poweredSensor(makeRomId(0x28, 1)), parasiteSensor(makeRomId(0x28, 2), true), eeprom(makeRomId(0x2D, 3)),
+          switchDevice(makeRomId(0x3A, 4)), bridge(makeRomId(0x19, 5), 0xA0), authenticator(makeRomId(0x17, 6)),
+          singleEeprom(makeRomId(0x2D, 7)),
+          multidrop(master), multidropResume(master), singledrop(singleMaster), forwardSearch(master),
+          poweredSensorDriver(multidrop), parasiteSensorDriver(multidrop), eepromDriver(multidropResume),
+          bridgeDriver(multidropResume), authenticatorDriver(multidropResume)
+    {
+        master.attach(poweredSensor);
+        master.attach(parasiteSensor);
+        master.attach(eeprom);
+        master.attach(switchDevice);
+        master.attach(bridge);
+        master.attach(authenticator);
+        singleMaster.attach(singleEeprom);
+        
+        master.OWInitMaster();
+        singleMaster.OWInitMaster();
+        
+        poweredSensorDriver.setRomId(poweredSensor.romId());
+        parasiteSensorDriver.setRomId(parasiteSensor.romId());
+        eepromDriver.setRomId(eeprom.romId());
+        bridgeDriver.setRomId(bridge.romId());
+        authenticatorDriver.setRomId(authenticator.romId());
+    }
+};
+
+/// Benchmarked operation, returns true on success.
+typedef bool (*Operation)(Fixture & fixture);
+
+struct Benchmark
+{
+    const char * name;
+    Operation setup;        ///< Run once before measuring, may be NULL.
+    Operation operation;
+    SimulatedOneWireMaster Fixture::*bus;
+};
+
+static bool owSearch(Fixture & fixture)
+{
+    if (fixture.searchState.last_device_flag)
+    {
+        fixture.searchState.reset();
+    }
+    return (RomCommands::OWSearch(fixture.master, fixture.searchState) == OneWireMaster::Success);
+}
+
+static bool owVerify(Fixture & fixture)
+{
+    return (RomCommands::OWVerify(fixture.master, fixture.eeprom.romId()) == OneWireMaster::Success);
+}
+
+static bool owMatchRom(Fixture & fixture)
+{
+    return (RomCommands::OWMatchRom(fixture.master, fixture.eeprom.romId()) == OneWireMaster::Success);
+}
+
+static bool owResume(Fixture & fixture)
+{
+    return (RomCommands::OWResume(fixture.master) == OneWireMaster::Success);
+}
+
+static bool owSkipRom(Fixture & fixture)
+{
+    return (RomCommands::OWSkipRom(fixture.master) == OneWireMaster::Success);
+}
+
+static bool forwardSearchEnumerate(Fixture & fixture)
+{
+    OneWireMaster::CmdResult result = fixture.forwardSearch.selectFirstDevice();
+    while ((result == OneWireMaster::Success) && !fixture.forwardSearch.lastDevice())
+    {
+        result = fixture.forwardSearch.selectNextDevice();
+    }
+    return (result == OneWireMaster::Success);
+}
+
+static bool forwardSearchFamily(Fixture & fixture)
+{
+    return (fixture.forwardSearch.selectFirstDeviceInFamily(SimulatedDS2431::familyCode) == OneWireMaster::Success);
+}
+
+static bool multidropSelect(Fixture & fixture)
+{
+    return (fixture.multidrop.selectDevice(fixture.eeprom.romId()) == OneWireMaster::Success);
+}
+
+static bool multidropResumeSelectSame(Fixture & fixture)
+{
+    return (fixture.multidropResume.selectDevice(fixture.eeprom.romId()) == OneWireMaster::Success);
+}
+
+static bool multidropResumeSelectAlternating(Fixture & fixture)
+{
+    static bool toggle = false;
+    toggle = !toggle;
+    return (fixture.multidropResume.selectDevice(toggle ? fixture.eeprom.romId() : fixture.bridge.romId()) == OneWireMaster::Success);
+}
+
+static bool singledropSelect(Fixture & fixture)
+{
+    return (fixture.singledrop.selectDevice() == OneWireMaster::Success);
+}
+
+static bool ds18b20ConvertPowered(Fixture & fixture)
+{
+    int16_t temp;
+    return (fixture.poweredSensorDriver.convertTemperature(temp) == OneWireSlave::Success);
+}
+
+static bool ds18b20ConvertParasite(Fixture & fixture)
+{
+    int16_t temp;
+    return (fixture.parasiteSensorDriver.convertTemperature(temp) == OneWireSlave::Success);
+}
+
+static bool ds2431WriteMemory(Fixture & fixture)
+{
+    DS2431::Scratchpad data;
+    data.fill(0xA5);
+    return (fixture.eepromDriver.writeMemory(0x0010, data) == OneWireSlave::Success);
+}
+
+static bool ds28e17WriteRead(Fixture & fixture)
+{
+    uint8_t pointer = 0x00;
+    uint8_t readData[4];
+    uint8_t status, wrStatus;
+    return ((fixture.bridgeDriver.writeReadDataWithStop(0xA0, 1, &pointer, sizeof(readData), status, wrStatus, readData) == DS28E17::Success) &&
+            (status == 0) && (wrStatus == 0));
+}
+
+static bool ds28e15ReadPageMac(Fixture & fixture)
+{
+    DS28E15::Mac mac;
+    return (fixture.authenticatorDriver.computeReadPageMac(0, false, mac) == OneWireSlave::Success);
+}
+
+static const Benchmark benchmarks[] =
+{
+    { "RomCommands::OWSearch", NULL, &owSearch, &Fixture::master },
+    { "RomCommands::OWVerify", NULL, &owVerify, &Fixture::master },
+    { "RomCommands::OWMatchRom", NULL, &owMatchRom, &Fixture::master },
+    { "RomCommands::OWResume", &owMatchRom, &owResume, &Fixture::master },
+    { "RomCommands::OWSkipRom", NULL, &owSkipRom, &Fixture::master },
+    { "ForwardSearchRomIterator::enumerate", NULL, &forwardSearchEnumerate, &Fixture::master },
+    { "ForwardSearchRomIterator::selectFirstDeviceInFamily", NULL, &forwardSearchFamily, &Fixture::master },
+    { "MultidropRomIterator::selectDevice", NULL, &multidropSelect, &Fixture::master },
+    { "MultidropRomIteratorWithResume::selectDevice(same)", NULL, &multidropResumeSelectSame, &Fixture::master },
+    { "MultidropRomIteratorWithResume::selectDevice(alternating)", NULL, &multidropResumeSelectAlternating, &Fixture::master },
+    { "SingledropRomIterator::selectDevice", NULL, &singledropSelect, &Fixture::singleMaster },
+    { "DS18B20::convertTemperature(powered)", NULL, &ds18b20ConvertPowered, &Fixture::master },
+    { "DS18B20::convertTemperature(parasite)", NULL, &ds18b20ConvertParasite, &Fixture::master },
+    { "DS2431::writeMemory", NULL, &ds2431WriteMemory, &Fixture::master },
+    { "DS28E17::writeReadDataWithStop", NULL, &ds28e17WriteRead, &Fixture::master },
+    { "DS28E15_22_25::computeReadPageMac", NULL, &ds28e15ReadPageMac, &Fixture::master }
+};
+
+static unsigned int runBenchmark(Fixture & fixture, const Benchmark & benchmark, unsigned int calls)
+{
+    SimulatedOneWireMaster & bus = fixture.*benchmark.bus;
+    unsigned int failures = 0;
+    
+    if ((benchmark.setup != NULL) && !benchmark.setup(fixture))
+    {
+        failures++;
+    }
+    
+    bus.resetCounters();
+    const uint64_t startNs = hostClock().nowNs();
+    for (unsigned int call = 0; call < calls; call++)
+    {
+        if (!benchmark.operation(fixture))
+        {
+            failures++;
+        }
+    }
+    const double elapsedNs = static_cast<double>(hostClock().nowNs() - startNs);
+    const SimulatedOneWireMaster::Counters & counters = bus.counters();
+    
+    printf("{\"benchmark\":\"%s\",\"calls\":%u,\"failures\":%u,\"bus_us\":%.2f,\"resets\":%.2f,"
+           "\"bytes\":%.2f,\"bits\":%.2f,\"slots\":%.2f}\n",
+           benchmark.name, calls, failures, elapsedNs / 1000.0 / calls,
+           static_cast<double>(counters.resets) / calls, static_cast<double>(counters.bytes) / calls,
+           static_cast<double>(counters.bits) / calls, static_cast<double>(counters.slots) / calls);
+    
+    return failures;
+}
+
+int main()
+{
+    Fixture fixture;
+    unsigned int failures = 0;
+    
+    for (size_t idx = 0; idx < (sizeof(benchmarks) / sizeof(benchmarks[0])); idx++)
+    {
+        failures += runBenchmark(fixture, benchmarks[idx], defaultCalls);
+    }
+    
+    return ((failures == 0) ? 0 : 1);
+}
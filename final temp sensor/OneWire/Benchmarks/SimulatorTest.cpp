@@ -0,0 +1,293 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+// Host regression test for the simulated bus and device models.
+//
+// Checks ROM search enumeration, DS18B20 conversions with local and parasite
+// power, DS2431 write and read back, DS28E15 Page MAC against
+// SimulatedSha256MacCoproc and the FIPS 180-4 SHA-256 test vectors. Each
+// failed check is written to stdout and the program exits with 1 if any
+// check failed.
+//
+// Host build, from the OneWire directory (a single command line):
+//
+//   g++ -O2 -I . -I Benchmarks/HostShims -o simulator_test
+//       Benchmarks/SimulatorTest.cpp Benchmarks/HostShims/HostClock.cpp
+//       Masters/OneWireMaster.cpp Masters/Simulated/*.cpp
+//       Masters/Simulated/Devices/*.cpp RomId/*.cpp Utilities/crc.cpp
+//       Slaves/Sensors/DS18B20/DS18B20.cpp Slaves/Memory/DS2431/DS2431.cpp
+//       Slaves/Authenticators/DS28E15_22_25/*.cpp
+
+#include <stdio.h>
+#include <string.h>
+#include "Benchmarks/HostShims/HostClock.h"
+#include "Masters/Simulated/Simulated.h"
+#include "Masters/Simulated/Sha256.h"
+#include "RomId/RomCommands.h"
+#include "RomId/RomIterator.h"
+#include "Slaves/Sensors/DS18B20/DS18B20.h"
+#include "Slaves/Memory/DS2431/DS2431.h"
+#include "Slaves/Authenticators/DS28E15_22_25/DS28E15.h"
+#include "Utilities/crc.h"
+
+using namespace OneWire;
+
+static unsigned int failures = 0;
+
+static void check(bool condition, const char * description)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", description);
+        failures++;
+    }
+}
+
+static RomId makeRomId(uint8_t familyCode, uint8_t serial)
+{
+    RomId romId;
+    romId.buffer.fill(0x00);
+    romId.familyCode() = familyCode;
+    romId.buffer[1] = serial;
+    romId.crc8() = crc::calculateCrc8(romId.buffer.data(), romId.buffer.size() - 1, 0x00);
+    return romId;
+}
+
+/// Multidrop bus with one of each tested device.
+struct Fixture
+{
+    SimulatedOneWireMaster master;
+    
+    SimulatedDS18B20 poweredSensor;
+    SimulatedDS18B20 parasiteSensor;
+    SimulatedDS2431 eeprom;
+    SimulatedDS28E15 authenticator;
+    
+    MultidropRomIterator multidrop;
+    
+    DS18B20 poweredSensorDriver;
+    DS18B20 parasiteSensorDriver;
+    DS2431 eepromDriver;
+    DS28E15 authenticatorDriver;
+    
+    Fixture()
+        : master(hostClock()),
+          poweredSensor(makeRomId(0x28, 1)), parasiteSensor(makeRomId(0x28, 2), true), eeprom(makeRomId(0x2D, 3)),
+          authenticator(makeRomId(0x17, 4), 0x5A, 0xA5),
+          multidrop(master), poweredSensorDriver(multidrop), parasiteSensorDriver(multidrop),
+          eepromDriver(multidrop), authenticatorDriver(multidrop)
+    {
+        master.attach(poweredSensor);
+        master.attach(parasiteSensor);
+        master.attach(eeprom);
+        master.attach(authenticator);
+        
+        master.OWInitMaster();
+        
+        poweredSensorDriver.setRomId(poweredSensor.romId());
+        parasiteSensorDriver.setRomId(parasiteSensor.romId());
+        eepromDriver.setRomId(eeprom.romId());
+        authenticatorDriver.setRomId(authenticator.romId());
+    }
+};
+
+static void testSearch()
+{
+    Fixture fixture;
+    const RomId expected[] =
+    {
+        fixture.poweredSensor.romId(), fixture.parasiteSensor.romId(),
+        fixture.eeprom.romId(), fixture.authenticator.romId()
+    };
+    const size_t expectedCount = (sizeof(expected) / sizeof(expected[0]));
+    unsigned int found[expectedCount] = { 0 };
+    unsigned int devices = 0;
+    
+    RomCommands::SearchState searchState;
+    OneWireMaster::CmdResult result = RomCommands::OWFirst(fixture.master, searchState);
+    while (result == OneWireMaster::Success)
+    {
+        devices++;
+        for (size_t idx = 0; idx < expectedCount; idx++)
+        {
+            if (searchState.romId == expected[idx])
+            {
+                found[idx]++;
+            }
+        }
+        result = RomCommands::OWNext(fixture.master, searchState);
+    }
+    
+    check(devices == expectedCount, "search finds every device");
+    for (size_t idx = 0; idx < expectedCount; idx++)
+    {
+        check(found[idx] == 1, "search finds each ROM ID exactly once");
+    }
+    
+    SimulatedOneWireMaster emptyMaster(hostClock());
+    emptyMaster.OWInitMaster();
+    RomCommands::SearchState emptyState;
+    check(RomCommands::OWFirst(emptyMaster, emptyState) != OneWireMaster::Success, "search fails on an empty bus");
+}
+
+static void testDS18B20(DS18B20 & driver, SimulatedDS18B20 & sensor, bool expectedLocalPower)
+{
+    const int16_t temperatures[] = { 0x0191, 0x0000, -0x0192 };
+    
+    bool localPower;
+    check((driver.readPowerSupply(localPower) == OneWireSlave::Success) && (localPower == expectedLocalPower),
+          "DS18B20 reports its power supply");
+    
+    for (size_t idx = 0; idx < (sizeof(temperatures) / sizeof(temperatures[0])); idx++)
+    {
+        sensor.setTemperature(temperatures[idx]);
+        int16_t temp;
+        check((driver.convertTemperature(temp) == OneWireSlave::Success) && (temp == temperatures[idx]),
+              "DS18B20 conversion returns the modelled temperature");
+    }
+    check(sensor.brownouts() == 0, "DS18B20 conversion keeps the device powered");
+}
+
+static void testDS2431()
+{
+    Fixture fixture;
+    const DS2431::Address address = 0x0010;
+    DS2431::Scratchpad data;
+    for (size_t idx = 0; idx < data.size(); idx++)
+    {
+        data[idx] = static_cast<uint8_t>(0xA0 + idx);
+    }
+    
+    check(fixture.eepromDriver.writeMemory(address, data) == OneWireSlave::Success, "DS2431 write memory");
+    
+    uint8_t readData[DS2431::Scratchpad::csize];
+    check((fixture.eepromDriver.readMemory(address, sizeof(readData), readData) == OneWireSlave::Success) &&
+          (memcmp(readData, data.data(), data.size()) == 0), "DS2431 read memory returns the written data");
+    check(memcmp(&fixture.eeprom.memory()[address], data.data(), data.size()) == 0, "DS2431 model holds the written data");
+}
+
+static void testDS28E15()
+{
+    Fixture fixture;
+    
+    // Derive a secret with the coprocessor and load it into the model so both
+    // sides share it.
+    SimulatedSha256MacCoproc macCoproc;
+    ISha256MacCoproc::Secret masterSecret;
+    masterSecret.fill(0x3C);
+    ISha256MacCoproc::DevicePage bindingPage;
+    bindingPage.fill(0x11);
+    ISha256MacCoproc::DeviceScratchpad partialSecret;
+    partialSecret.fill(0x22);
+    ISha256MacCoproc::SlaveSecretData slaveSecretData;
+    slaveSecretData.fill(0x33);
+    macCoproc.setMasterSecret(masterSecret);
+    macCoproc.computeSlaveSecret(bindingPage, partialSecret, slaveSecretData);
+    fixture.authenticator.setSecret(macCoproc.slaveSecret());
+    
+    DS28E15::Page & page = fixture.authenticator.page(1);
+    for (size_t idx = 0; idx < page.size(); idx++)
+    {
+        page[idx] = static_cast<uint8_t>(idx);
+    }
+    DS28E15::Scratchpad challenge;
+    challenge.fill(0xC5);
+    check(fixture.authenticatorDriver.writeScratchpad(challenge) == OneWireSlave::Success, "DS28E15 write scratchpad");
+    
+    const DS28E15::ManId manId = { 0x5A, 0xA5 };
+    DS28E15::Mac expected, mac;
+    
+    DS28E15::computeAuthMac(macCoproc, page, 1, challenge, fixture.authenticator.romId(), manId, expected);
+    check((fixture.authenticatorDriver.computeReadPageMac(1, false, mac) == OneWireSlave::Success) && (mac == expected),
+          "DS28E15 Page MAC matches the coprocessor");
+    
+    DS28E15::computeAuthMacAnon(macCoproc, page, 1, challenge, manId, expected);
+    check((fixture.authenticatorDriver.computeReadPageMac(1, true, mac) == OneWireSlave::Success) && (mac == expected),
+          "DS28E15 anonymous Page MAC matches the coprocessor");
+}
+
+static bool hashEquals(const char * message, size_t messageLen, const uint8_t (&expected)[32])
+{
+    Sha256 sha;
+    Sha256::Hash hash;
+    sha.update(reinterpret_cast<const uint8_t *>(message), messageLen);
+    sha.finish(hash);
+    return (memcmp(hash.data(), expected, sizeof(expected)) == 0);
+}
+
+static void testSha256()
+{
+    static const uint8_t emptyHash[32] =
+    {
+        0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+        0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55
+    };
+    static const uint8_t abcHash[32] =
+    {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+        0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+    };
+    static const uint8_t twoBlockHash[32] =
+    {
+        0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+        0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1
+    };
+    static const char twoBlockMessage[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    
+    check(hashEquals("", 0, emptyHash), "SHA-256 of the empty message");
+    check(hashEquals("abc", 3, abcHash), "SHA-256 of \"abc\"");
+    check(hashEquals(twoBlockMessage, sizeof(twoBlockMessage) - 1, twoBlockHash), "SHA-256 of the 448-bit message");
+    
+    // Split updates must hash the same as a single update.
+    Sha256 sha;
+    Sha256::Hash hash;
+    sha.update(reinterpret_cast<const uint8_t *>(twoBlockMessage), 5);
+    sha.update(reinterpret_cast<const uint8_t *>(twoBlockMessage) + 5, sizeof(twoBlockMessage) - 1 - 5);
+    sha.finish(hash);
+    check(memcmp(hash.data(), twoBlockHash, sizeof(twoBlockHash)) == 0, "SHA-256 of split updates");
+}
+
+int main()
+{
+    testSearch();
+    
+    Fixture fixture;
+    testDS18B20(fixture.poweredSensorDriver, fixture.poweredSensor, true);
+    testDS18B20(fixture.parasiteSensorDriver, fixture.parasiteSensor, false);
+    
+    testDS2431();
+    testDS28E15();
+    testSha256();
+    
+    printf("%u failures\n", failures);
+    return ((failures == 0) ? 0 : 1);
+}
@@ -0,0 +1,287 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_BasicOneWireMaster
+#define OneWire_Masters_BasicOneWireMaster
+
+#include "Masters/OneWireMaster.h"
+
+namespace OneWire
+{
+    template <class Master>
+    OneWireMaster::CmdResult tripletSearchRom(Master & master, uint8_t * romBuf, uint8_t * discrepancies);
+    
+    /**
+    * @brief Base for 1-Wire masters with a statically dispatched interface
+    *
+    * @details Impl derives from BasicOneWireMaster<Impl> and provides the
+    * non-virtual primitives reset(), touchBitSetLevel(), setSpeed() and 
+    * setLevel(). Byte, block, triplet and search operations are built on top of 
+    * them here without virtual calls, and Impl may hide any of these 
+    * defaults with a native version of the same signature. The virtual 
+    * OneWireMaster interface is implemented as a thin adapter over the
+    * static one, so an Impl can still be used through OneWireMaster &.
+    *
+    * Code templated on the master type, such as the RomCommands 
+    * overloads for BasicOneWireMaster, calls the static interface so 
+    * that per-bit and per-byte calls can be inlined.
+    *
+    * @code
+    * class MyMaster : public BasicOneWireMaster<MyMaster>
+    * {
+    * public:
+    *     virtual CmdResult OWInitMaster();
+    *     CmdResult reset();
+    *     CmdResult touchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel);
+    *     CmdResult setSpeed(OWSpeed newSpeed);
+    *     CmdResult setLevel(OWLevel newLevel);
+    * };
+    * @endcode
+    */
+    template <class Impl>
+    class BasicOneWireMaster : public OneWireMaster
+    {
+    public:
+        /// @{
+        /// Statically dispatched defaults built from the primitives of Impl.
+        CmdResult writeBitSetLevel(uint8_t sendBit, OWLevel afterLevel) { return impl().touchBitSetLevel(sendBit, afterLevel); }
+        CmdResult readBitSetLevel(uint8_t & recvBit, OWLevel afterLevel) { recvBit = 0x01; return impl().touchBitSetLevel(recvBit, afterLevel); }
+        CmdResult writeByteSetLevel(uint8_t sendByte, OWLevel afterLevel);
+        CmdResult readByteSetLevel(uint8_t & recvByte, OWLevel afterLevel);
+        CmdResult writeBlock(const uint8_t * sendBuf, size_t sendLen);
+        CmdResult readBlock(uint8_t * recvBuf, size_t recvLen);
+        CmdResult triplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb);
+        CmdResult searchRom(uint8_t * romBuf, uint8_t * discrepancies) { return tripletSearchRom(impl(), romBuf, discrepancies); }
+        /// @}
+        
+        /// @{
+        /// OneWireMaster interface, forwards to the static interface of Impl.
+        virtual CmdResult OWReset() { return impl().reset(); }
+        virtual CmdResult OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel) { return impl().touchBitSetLevel(sendRecvBit, afterLevel); }
+        virtual CmdResult OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel) { return impl().writeByteSetLevel(sendByte, afterLevel); }
+        virtual CmdResult OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel) { return impl().readByteSetLevel(recvByte, afterLevel); }
+        virtual CmdResult OWWriteBlock(const uint8_t *sendBuf, size_t sendLen) { return impl().writeBlock(sendBuf, sendLen); }
+        virtual CmdResult OWReadBlock(uint8_t *recvBuf, size_t recvLen) { return impl().readBlock(recvBuf, recvLen); }
+        virtual CmdResult OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb) { return impl().triplet(searchDirection, sbr, tsb); }
+        virtual CmdResult OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies) { return impl().searchRom(romBuf, discrepancies); }
+        virtual CmdResult OWSetSpeed(OWSpeed newSpeed) { return impl().setSpeed(newSpeed); }
+        virtual CmdResult OWSetLevel(OWLevel newLevel) { return impl().setLevel(newLevel); }
+        /// @}
+        
+    protected:
+        BasicOneWireMaster() { }
+        
+    private:
+        Impl & impl() { return static_cast<Impl &>(*this); }
+    };
+    
+    /// Static interface over the virtual functions of any OneWireMaster, for
+    /// instantiating code templated on the master type without a concrete type.
+    class OneWireMasterRef
+    {
+    public:
+        typedef OneWireMaster::CmdResult CmdResult;
+        typedef OneWireMaster::OWLevel OWLevel;
+        typedef OneWireMaster::OWSpeed OWSpeed;
+        typedef OneWireMaster::SearchDirection SearchDirection;
+        
+        explicit OneWireMasterRef(OneWireMaster & master) : m_master(master) { }
+        
+        /// The adapted master.
+        OneWireMaster & master() const { return m_master; }
+        
+        CmdResult reset() { return m_master.OWReset(); }
+        CmdResult touchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel) { return m_master.OWTouchBitSetLevel(sendRecvBit, afterLevel); }
+        CmdResult writeBitSetLevel(uint8_t sendBit, OWLevel afterLevel) { return m_master.OWWriteBitSetLevel(sendBit, afterLevel); }
+        CmdResult readBitSetLevel(uint8_t & recvBit, OWLevel afterLevel) { return m_master.OWReadBitSetLevel(recvBit, afterLevel); }
+        CmdResult writeByteSetLevel(uint8_t sendByte, OWLevel afterLevel) { return m_master.OWWriteByteSetLevel(sendByte, afterLevel); }
+        CmdResult readByteSetLevel(uint8_t & recvByte, OWLevel afterLevel) { return m_master.OWReadByteSetLevel(recvByte, afterLevel); }
+        CmdResult writeBlock(const uint8_t * sendBuf, size_t sendLen) { return m_master.OWWriteBlock(sendBuf, sendLen); }
+        CmdResult readBlock(uint8_t * recvBuf, size_t recvLen) { return m_master.OWReadBlock(recvBuf, recvLen); }
+        CmdResult triplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb) { return m_master.OWTriplet(searchDirection, sbr, tsb); }
+        CmdResult searchRom(uint8_t * romBuf, uint8_t * discrepancies) { return m_master.OWSearchRom(romBuf, discrepancies); }
+        CmdResult setSpeed(OWSpeed newSpeed) { return m_master.OWSetSpeed(newSpeed); }
+        CmdResult setLevel(OWLevel newLevel) { return m_master.OWSetLevel(newLevel); }
+        
+    private:
+        OneWireMaster & m_master;
+    };
+    
+    template <class Impl>
+    OneWireMaster::CmdResult BasicOneWireMaster<Impl>::writeByteSetLevel(uint8_t sendByte, OWLevel afterLevel)
+    {
+        CmdResult result = Success;
+        
+        for (unsigned int idx = 0; (idx < 8) && (result == Success); idx++)
+        {
+            result = impl().writeBitSetLevel(0x01 & (sendByte >> idx), NormalLevel);
+        }
+        
+        if (result == Success)
+        {
+            result = impl().setLevel(afterLevel);
+        }
+        
+        return result;
+    }
+    
+    template <class Impl>
+    OneWireMaster::CmdResult BasicOneWireMaster<Impl>::readByteSetLevel(uint8_t & recvByte, OWLevel afterLevel)
+    {
+        CmdResult result = Success;
+        uint8_t recvBit;
+        recvByte = 0;
+        
+        for (unsigned int idx = 0; (idx < 8) && (result == Success); idx++)
+        {
+            result = impl().readBitSetLevel(recvBit, NormalLevel);
+            recvByte |= ((0x01 & recvBit) << idx);
+        }
+        
+        if (result == Success)
+        {
+            result = impl().setLevel(afterLevel);
+        }
+        
+        return result;
+    }
+    
+    template <class Impl>
+    OneWireMaster::CmdResult BasicOneWireMaster<Impl>::writeBlock(const uint8_t * sendBuf, size_t sendLen)
+    {
+        CmdResult result = OperationFailure;
+        
+        for (size_t idx = 0; idx < sendLen; idx++)
+        {
+            result = impl().writeByteSetLevel(sendBuf[idx], NormalLevel);
+            if (result != Success)
+            {
+                break;
+            }
+        }
+        
+        return result;
+    }
+    
+    template <class Impl>
+    OneWireMaster::CmdResult BasicOneWireMaster<Impl>::readBlock(uint8_t * recvBuf, size_t recvLen)
+    {
+        CmdResult result = OperationFailure;
+        
+        for (size_t idx = 0; idx < recvLen; idx++)
+        {
+            result = impl().readByteSetLevel(recvBuf[idx], NormalLevel);
+            if (result != Success)
+            {
+                break;
+            }
+        }
+        
+        return result;
+    }
+    
+    template <class Impl>
+    OneWireMaster::CmdResult BasicOneWireMaster<Impl>::triplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb)
+    {
+        CmdResult result = impl().readBitSetLevel(sbr, NormalLevel);
+        if (result == Success)
+        {
+            result = impl().readBitSetLevel(tsb, NormalLevel);
+        }
+        if (result == Success)
+        {
+            if (sbr)
+            {
+                searchDirection = WriteOne;
+            }
+            else if (tsb)
+            {
+                searchDirection = WriteZero;
+            }
+            // else: use searchDirection parameter
+            
+            result = impl().writeBitSetLevel((searchDirection == WriteOne) ? 1 : 0, NormalLevel);
+        }
+        return result;
+    }
+    
+    /// Search for the next ROM ID with one triplet per bit of the ROM ID.
+    /// @details Shared by every master type providing the static triplet(),
+    ///          including OneWireMasterRef for the virtual interface.
+    template <class Master>
+    OneWireMaster::CmdResult tripletSearchRom(Master & master, uint8_t * romBuf, uint8_t * discrepancies)
+    {
+        OneWireMaster::CmdResult result = OneWireMaster::Success;
+        OneWireMaster::SearchDirection searchDirection;
+        uint8_t sbr, tsb, bitMask;
+        
+        for (size_t idx = 0; (idx < 64) && (result == OneWireMaster::Success); idx++)
+        {
+            bitMask = (1 << (idx % 8));
+            searchDirection = (((romBuf[idx / 8] & bitMask) != 0) ? OneWireMaster::WriteOne : OneWireMaster::WriteZero);
+            
+            result = master.triplet(searchDirection, sbr, tsb);
+            if (result == OneWireMaster::Success)
+            {
+                // check for no devices on 1-wire
+                if (sbr && tsb)
+                {
+                    result = OneWireMaster::OperationFailure;
+                }
+                else
+                {
+                    if (searchDirection == OneWireMaster::WriteOne)
+                    {
+                        romBuf[idx / 8] |= bitMask;
+                    }
+                    else
+                    {
+                        romBuf[idx / 8] &= ~bitMask;
+                    }
+                    
+                    if (!sbr && !tsb)
+                    {
+                        discrepancies[idx / 8] |= bitMask;
+                    }
+                    else
+                    {
+                        discrepancies[idx / 8] &= ~bitMask;
+                    }
+                }
+            }
+        }
+        
+        return result;
+    }
+}
+
+#endif
@@ -33,12 +33,13 @@
 #include "Masters/DS2465/DS2465.h"
 #include "I2C.h"
 #include "wait_api.h"
+#include "Timeout.h"
+#include "rtos/Semaphore.h"
+#include <algorithm>
+#include <cstring>
 
 using namespace OneWire;
 
-#define I2C_WRITE 0
-#define I2C_READ 1
-
 /// DS2465 Commands
 enum Command
 {
@@ -72,9 +73,40 @@ enum StatusBit
     Status_DIR = 0x80
 };
 
-static const int I2C_WRITE_OK = 1;
+static const int I2C_WRITE_OK = 0;
+static const int I2C_READ_OK = 0;
+/// Largest SRAM write sent in one I2C transfer.
+static const size_t maxWriteChunk = 64;
+#if DEVICE_I2C_ASYNCH
+/// Generous bound for a transfer of up to 65 bytes at 100 kHz.
+static const uint32_t transferTimeoutMs = 20;
+#endif
 static const uint8_t maxBlockSize = 63;
 
+/// Nominal 1-Wire timing used to predict how long a command keeps the DS2465 busy.
+/// @{
+static const unsigned int standardResetTimeUs = 1148;
+static const unsigned int standardSlotTimeUs = 69;
+static const unsigned int overdriveResetTimeUs = 146;
+static const unsigned int overdriveSlotTimeUs = 10;
+/// @}
+
+/// Timer interrupt handler that ends sleepUs().
+static void releaseSemaphore(rtos::Semaphore * semaphore)
+{
+    semaphore->release();
+}
+
+/// Sleep for the given time yielding to other threads until a timer interrupt
+/// wakes this one, so waits under 1 ms do not spin.
+static void sleepUs(unsigned int timeUs)
+{
+    rtos::Semaphore wakeup(0);
+    mbed::Timeout timer;
+    timer.attach_us(mbed::callback(releaseSemaphore, &wakeup), timeUs);
+    wakeup.wait();
+}
+
 uint8_t DS2465::Config::readByte() const
 {
     uint8_t config = 0;
@@ -112,9 +144,18 @@ void DS2465::Config::reset()
 }
 
 DS2465::DS2465(mbed::I2C & I2C_interface, uint8_t I2C_address)
-    : m_I2C_interface(I2C_interface), m_I2C_address(I2C_address)
+    : m_I2C_interface(I2C_interface), m_I2C_address(I2C_address), m_strongPullup(false)
 {
+#if DEVICE_I2C_ASYNCH
+    m_transferEvent = 0;
+#endif
+    resetPollCounters();
+}
 
+void DS2465::resetPollCounters()
+{
+    m_pollCounters.commands = 0;
+    m_pollCounters.polls = 0;
 }
 
 OneWireMaster::CmdResult DS2465::OWInitMaster()
@@ -258,17 +299,17 @@ OneWireMaster::CmdResult DS2465::copyScratchpad(bool destSecret, unsigned int pa
 
 OneWireMaster::CmdResult DS2465::configureLevel(OWLevel level)
 {
-    OneWireMaster::CmdResult result;
-    if (m_curConfig.getSPU() != (level == StrongLevel))
+    // A normal level needs no configuration write since the next 1-Wire
+    // command ends any active strong pullup and the DS2465 clears SPU itself.
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
+    if (level == StrongLevel)
     {
         Config newConfig = m_curConfig;
-        newConfig.setSPU(level == StrongLevel);
-        result = writeConfig(newConfig, true);
-    }
-    else
-    {
-        result = OneWireMaster::Success;
+        newConfig.setSPU(true);
+        uint8_t configBuf = newConfig.writeByte();
+        result = writeMemory(ConfigReg, &configBuf, 1);
     }
+    m_strongPullup = ((level == StrongLevel) && (result == OneWireMaster::Success));
     return result;
 }
 
@@ -279,7 +320,19 @@ OneWireMaster::CmdResult DS2465::OWSetLevel(OWLevel newLevel)
         return OneWireMaster::OperationFailure;
     }
 
-    return configureLevel(newLevel);
+    if (!m_strongPullup)
+    {
+        return OneWireMaster::Success;
+    }
+
+    // End the strong pullup by writing the configuration with SPU cleared.
+    uint8_t configBuf = m_curConfig.writeByte();
+    OneWireMaster::CmdResult result = writeMemory(ConfigReg, &configBuf, 1);
+    if (result == OneWireMaster::Success)
+    {
+        m_strongPullup = false;
+    }
+    return result;
 }
 
 OneWireMaster::CmdResult DS2465::OWSetSpeed(OWSpeed newSpeed)
@@ -313,7 +366,7 @@ OneWireMaster::CmdResult DS2465::OWTriplet(SearchDirection & searchDirection, ui
     if (result == OneWireMaster::Success)
     {
         uint8_t status;
-        result = pollBusy(&status);
+        result = pollBusy(busyTimeUs(3), &status);
         if (result == OneWireMaster::Success)
         {
             // check bit results in status byte
@@ -322,6 +375,10 @@ OneWireMaster::CmdResult DS2465::OWTriplet(SearchDirection & searchDirection, ui
             searchDirection = ((status & Status_DIR) == Status_DIR) ? WriteOne : WriteZero;
         }
     }
+
+    // The 1-Wire command ended any strong pullup.
+    m_strongPullup = false;
+
     return result;
 }
 
@@ -339,13 +396,17 @@ OneWireMaster::CmdResult DS2465::OWReadBlock(uint8_t *recvBuf, size_t recvLen)
         result = writeMemory(CommandReg, command, 2);
         if (result == OneWireMaster::Success)
         {
-            result = pollBusy();
+            result = pollBusy(busyTimeUs(8 * command[1]));
         }
         if (result == OneWireMaster::Success)
         {
             result = readMemory(Scratchpad, recvBuf + i, command[1], false);
         }
     }
+
+    // The 1-Wire command ended any strong pullup.
+    m_strongPullup = false;
+
     return result;
 }
 
@@ -369,9 +430,13 @@ OneWireMaster::CmdResult DS2465::OWWriteBlock(const uint8_t *sendBuf, size_t sen
         }
         if (result == OneWireMaster::Success)
         {
-            result = pollBusy();
+            result = pollBusy(busyTimeUs(8 * command[1]));
         }
     }
+
+    // The 1-Wire command ended any strong pullup.
+    m_strongPullup = false;
+
     return result;
 }
 
@@ -386,8 +451,12 @@ OneWireMaster::CmdResult DS2465::OWWriteBlockMac()
     OneWireMaster::CmdResult result = writeMemory(CommandReg, command, 2);
     if (result == OneWireMaster::Success)
     {
-        result = pollBusy();
+        result = pollBusy(busyTimeUs(8 * 32));
     }
+
+    // The 1-Wire command ended any strong pullup.
+    m_strongPullup = false;
+
     return result;
 }
 
@@ -416,7 +485,7 @@ OneWireMaster::CmdResult DS2465::OWReadByteSetLevel(uint8_t & recvByte, OWLevel
 
     if (result == OneWireMaster::Success)
     {
-        result = pollBusy();
+        result = pollBusy(busyTimeUs(8));
     }
 
     if (result == OneWireMaster::Success)
@@ -454,7 +523,7 @@ OneWireMaster::CmdResult DS2465::OWWriteByteSetLevel(uint8_t sendByte, OWLevel a
     result = writeMemory(CommandReg, command, 2);
     if (result == OneWireMaster::Success)
     {
-        result = pollBusy();
+        result = pollBusy(busyTimeUs(8));
     }
 
     return result;
@@ -484,12 +553,12 @@ OneWireMaster::CmdResult DS2465::OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLev
 
     if (result == OneWireMaster::Success)
     {
-        result = pollBusy(&status);
+        result = pollBusy(busyTimeUs(1), &status);
     }
 
     if (result == OneWireMaster::Success)
     {
-        sendRecvBit = (status & Status_SBR);
+        sendRecvBit = ((status & Status_SBR) == Status_SBR);
     }
 
     return result;
@@ -505,27 +574,20 @@ OneWireMaster::CmdResult DS2465::cWriteMemory(uint8_t addr, const uint8_t * buf,
     //  VSA valid SRAM memory address
     //  DD memory data to write
 
-    m_I2C_interface.start();
-    if (m_I2C_interface.write((m_I2C_address | I2C_WRITE)) != I2C_WRITE_OK)
-    {
-        m_I2C_interface.stop();
-        return OneWireMaster::CommunicationWriteError;
-    }
-    if (m_I2C_interface.write(addr) != I2C_WRITE_OK)
-    {
-        m_I2C_interface.stop();
-        return OneWireMaster::CommunicationWriteError;
-    }
-    // loop to write each byte
-    for (size_t i = 0; i < bufLen; i++)
+    // The address auto-increments so longer writes are split into chunks.
+    uint8_t writeBuf[1 + maxWriteChunk];
+    size_t i = 0;
+    do
     {
-        if (m_I2C_interface.write(buf[i]) != I2C_WRITE_OK)
+        const size_t chunkLen = std::min(bufLen - i, maxWriteChunk);
+        writeBuf[0] = static_cast<uint8_t>(addr + i);
+        std::memcpy(&writeBuf[1], buf + i, chunkLen);
+        if (i2cTransfer(writeBuf, 1 + chunkLen, NULL, 0) != OneWireMaster::Success)
         {
-            m_I2C_interface.stop();
             return OneWireMaster::CommunicationWriteError;
         }
-    }
-    m_I2C_interface.stop();
+        i += chunkLen;
+    } while (i < bufLen);
 
     return OneWireMaster::Success;
 }
@@ -540,36 +602,67 @@ OneWireMaster::CmdResult DS2465::readMemory(uint8_t addr, uint8_t * buf, size_t
     //  MA memory address
     //  DD memory data read
 
-    m_I2C_interface.start();
-    if (!skipSetPointer)
+    return i2cTransfer((skipSetPointer ? NULL : &addr), (skipSetPointer ? 0 : 1), buf, bufLen);
+}
+
+OneWireMaster::CmdResult DS2465::i2cTransfer(const uint8_t * txBuf, size_t txLen, uint8_t * rxBuf, size_t rxLen) const
+{
+    const int i2cAddress = m_I2C_address;
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
+
+#if DEVICE_I2C_ASYNCH
+    // Let the I2C peripheral move the bytes while this thread sleeps.
+    while (m_transferSemaphore.wait(0) > 0);
+    m_transferEvent = 0;
+    if (m_I2C_interface.transfer(i2cAddress, reinterpret_cast<const char *>(txBuf), static_cast<int>(txLen),
+                                 reinterpret_cast<char *>(rxBuf), static_cast<int>(rxLen),
+                                 mbed::callback(this, &DS2465::transferComplete), I2C_EVENT_ALL) != 0)
+    {
+        result = ((txLen > 0) ? OneWireMaster::CommunicationWriteError : OneWireMaster::CommunicationReadError);
+    }
+    else if (m_transferSemaphore.wait(transferTimeoutMs) <= 0)
+    {
+        m_I2C_interface.abort_transfer();
+        result = OneWireMaster::TimeoutError;
+    }
+    else if (m_transferEvent != I2C_EVENT_TRANSFER_COMPLETE)
+    {
+        result = ((txLen > 0) ? OneWireMaster::CommunicationWriteError : OneWireMaster::CommunicationReadError);
+    }
+#else
+    // The write and read are joined by a repeated start so keep other I2C users off the bus.
+    m_I2C_interface.lock();
+    if (txLen > 0)
     {
-        if (m_I2C_interface.write((m_I2C_address | I2C_WRITE)) != I2C_WRITE_OK)
+        if (m_I2C_interface.write(i2cAddress, reinterpret_cast<const char *>(txBuf), static_cast<int>(txLen), (rxLen > 0)) != I2C_WRITE_OK)
         {
-            m_I2C_interface.stop();
-            return OneWireMaster::CommunicationWriteError;
+            if (rxLen > 0)
+            {
+                m_I2C_interface.stop();
+            }
+            result = OneWireMaster::CommunicationWriteError;
         }
-        if (m_I2C_interface.write(addr) != I2C_WRITE_OK)
+    }
+    if ((result == OneWireMaster::Success) && (rxLen > 0))
+    {
+        if (m_I2C_interface.read(i2cAddress, reinterpret_cast<char *>(rxBuf), static_cast<int>(rxLen)) != I2C_READ_OK)
         {
-            m_I2C_interface.stop();
-            return OneWireMaster::CommunicationWriteError;
+            result = OneWireMaster::CommunicationReadError;
         }
-        m_I2C_interface.start();
     }
+    m_I2C_interface.unlock();
+#endif
 
-    if (m_I2C_interface.write((m_I2C_address | I2C_READ)) != I2C_WRITE_OK)
-    {
-        m_I2C_interface.stop();
-        return OneWireMaster::CommunicationWriteError;
-    }
-    // loop to read each byte, NAK last byte
-    for (size_t i = 0; i < bufLen; i++)
-    {
-        buf[i] = m_I2C_interface.read((i == (bufLen - 1)) ? mbed::I2C::NoACK : mbed::I2C::ACK);
-    }
-    m_I2C_interface.stop();
+    return result;
+}
 
-    return OneWireMaster::Success;
+#if DEVICE_I2C_ASYNCH
+void DS2465::transferComplete(int event) const
+{
+    m_transferEvent = event;
+    m_transferSemaphore.release();
 }
+#endif
 
 OneWireMaster::CmdResult DS2465::writeConfig(const Config & config, bool verify)
 {
@@ -593,13 +686,31 @@ OneWireMaster::CmdResult DS2465::writeConfig(const Config & config, bool verify)
 
     if (result == OneWireMaster::Success)
     {
+        // SPU only arms the strong pullup for the next 1-Wire command and is
+        // cleared by the DS2465 when that pullup ends.
         m_curConfig = config;
+        m_curConfig.setSPU(false);
+        m_strongPullup = config.getSPU();
     }
 
     return result;
 }
 
-OneWireMaster::CmdResult DS2465::pollBusy(uint8_t * pStatus)
+unsigned int DS2465::busyTimeUs(unsigned int slots) const
+{
+    unsigned int timeUs;
+    if (m_curConfig.get1WS())
+    {
+        timeUs = ((slots > 0) ? (slots * overdriveSlotTimeUs) : overdriveResetTimeUs);
+    }
+    else
+    {
+        timeUs = ((slots > 0) ? (slots * standardSlotTimeUs) : standardResetTimeUs);
+    }
+    return timeUs;
+}
+
+OneWireMaster::CmdResult DS2465::pollBusy(unsigned int timeUs, uint8_t * pStatus)
 {
     const unsigned int pollLimit = 200;
 
@@ -607,24 +718,34 @@ OneWireMaster::CmdResult DS2465::pollBusy(uint8_t * pStatus)
     uint8_t status;
     unsigned int pollCount = 0;
 
+    // Sleep through the expected command time instead of polling during it.
+    // The command write ended with a stop so other I2C users can use the bus.
+    sleepUs(timeUs);
+    m_pollCounters.commands++;
+
+    // Keep other I2C users off the bus until the status shows completion.
+    m_I2C_interface.lock();
     do
     {
         result = readMemory(StatusReg, &status, 1, true);
         if (result != OneWireMaster::Success)
         {
-            return result;
+            break;
         }
+        m_pollCounters.polls++;
         if (pStatus != NULL)
         {
             *pStatus = status;
         }
         if (pollCount++ >= pollLimit)
         {
-            return OneWireMaster::TimeoutError;
+            result = OneWireMaster::TimeoutError;
+            break;
         }
     } while (status & Status_1WB);
+    m_I2C_interface.unlock();
 
-    return OneWireMaster::Success;
+    return result;
 }
 
 OneWireMaster::CmdResult DS2465::OWReset()
@@ -643,7 +764,7 @@ OneWireMaster::CmdResult DS2465::OWReset()
 
     if (result == OneWireMaster::Success)
     {
-        result = pollBusy(&buf);
+        result = pollBusy(busyTimeUs(0), &buf);
     }
 
     if (result == OneWireMaster::Success)
@@ -655,6 +776,9 @@ OneWireMaster::CmdResult DS2465::OWReset()
         }
     }
 
+    // The 1-Wire command ended any strong pullup.
+    m_strongPullup = false;
+
     return result;
 }
 
@@ -35,6 +35,9 @@
 
 #include "Masters/OneWireMaster.h"
 #include "Slaves/Authenticators/ISha256MacCoproc.h"
+#if DEVICE_I2C_ASYNCH
+#include "rtos/Semaphore.h"
+#endif
 
 namespace mbed { class I2C; }
 
@@ -136,6 +139,17 @@ namespace OneWire
         /// @param verify Verify that the configuration was written successfully.
         OneWireMaster::CmdResult writeConfig(const Config & config, bool verify);
 
+        /// Status polling statistics. Commands counts the 1-Wire commands waited on,
+        /// polls counts every status register read while waiting.
+        struct PollCounters
+        {
+            uint32_t commands;
+            uint32_t polls;
+        };
+
+        const PollCounters & pollCounters() const { return m_pollCounters; }
+        void resetPollCounters();
+
         /// Read the current DS2465 configuration.
         /// @returns The cached current configuration.
         Config currentConfig() const { return m_curConfig; }
@@ -234,14 +248,33 @@ namespace OneWire
         mbed::I2C & m_I2C_interface;
         uint8_t m_I2C_address;
         Config m_curConfig;
+        PollCounters m_pollCounters;
+        bool m_strongPullup;
+#if DEVICE_I2C_ASYNCH
+        mutable rtos::Semaphore m_transferSemaphore;
+        mutable volatile int m_transferEvent;
+
+        /// Asynchronous I2C transfer event handler.
+        void transferComplete(int event) const;
+#endif
+
+        /// Write and then read the DS2465 as one I2C transaction joined by a repeated start.
+        /// @param txBuf Bytes to write or NULL if none.
+        /// @param rxBuf Buffer for bytes read or NULL if none.
+        OneWireMaster::CmdResult i2cTransfer(const uint8_t * txBuf, size_t txLen, uint8_t * rxBuf, size_t rxLen) const;
 
         /// Polls the DS2465 status waiting for the 1-Wire Busy bit (1WB) to be cleared.
+        /// @param timeUs Expected command time to sleep before the first poll.
         /// @param[out] pStatus Optionally retrive the status byte when 1WB cleared.
         /// @returns Success or TimeoutError if poll limit reached.
-        OneWireMaster::CmdResult pollBusy(uint8_t * pStatus = NULL);
+        OneWireMaster::CmdResult pollBusy(unsigned int timeUs, uint8_t * pStatus = NULL);
+
+        /// Expected time in microseconds that a 1-Wire command keeps the DS2465 busy at the current speed.
+        /// @param slots Number of 1-Wire time slots, or zero for a 1-Wire reset.
+        unsigned int busyTimeUs(unsigned int slots) const;
 
-        /// Ensure that the desired 1-Wire level is set in the configuration.
-        /// @param level Desired 1-Wire level.
+        /// Arm the strong pullup for the next 1-Wire command if a strong level is desired.
+        /// @param level Desired 1-Wire level after the next 1-Wire command.
         OneWireMaster::CmdResult configureLevel(OWLevel level);
 
         /// Const version of writeMemory() for internal use.
@@ -31,9 +31,11 @@
 **********************************************************************/
 
 #include "Masters/DS2480B/DS2480B.h"
-#include "Serial.h"
-#include "Timer.h"
+#include "Masters/OneWireTransaction.h"
+#include "RomId/RomCommands.h"
 #include "wait_api.h"
+#include <algorithm>
+#include <cstring>
 
 // Mode Commands
 #define MODE_DATA                      0xE1
@@ -201,57 +203,139 @@ static uint32_t calculateBitTimeout(DS2480B::BaudRate baud)
     return timeout;
 }
 
-DS2480B::DS2480B(PinName tx, PinName rx)
-    : serial(tx, rx)
+const size_t DS2480B::queueSendSize;
+const size_t DS2480B::queueResponseSize;
+const size_t DS2480B::rxBufferSize;
+
+/// Convert a timeout from calculateBitTimeout() to whole ms for a semaphore.
+static uint32_t timeoutMs(uint32_t timeoutUs)
 {
-    
+    return (((timeoutUs + 999) / 1000) + 1);
+}
+
+DS2480B::DS2480B(PinName tx, PinName rx, BaudRate maxBaud)
+    : lineProfile(), maxBaud(maxBaud), linkBaud(Baud9600bps), serial(tx, rx), rxHead(0), rxTail(0), rxWaitCount(0), rxOverrun(false), rxSemaphore(0),
+      txData(NULL), txRemaining(0), txSemaphore(0), batchDepth(0), queuedSendLen(0), queuedResponses(0)
+{
+    serial.attach(this, &DS2480B::rxIrq, mbed::SerialBase::RxIrq);
 }
 
 OneWireMaster::CmdResult DS2480B::OWInitMaster()
 {
-    return detect();
+    OneWireMaster::CmdResult result = detect();
+    if (result == OneWireMaster::Success)
+    {
+        result = negotiateBaud();
+    }
+
+    return result;
 }
 
-OneWireMaster::CmdResult DS2480B::OWReset()
+OneWireMaster::CmdResult DS2480B::negotiateBaud()
 {
-    OneWireMaster::CmdResult result;
+    static const BaudRate candidates[] = { Baud115200bps, Baud57600bps, Baud19200bps };
 
-    uint8_t readbuffer[10], sendpacket[10];
-    uint8_t sendlen = 0;
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
 
-    // make sure normal level
-    result = OWSetLevel(OneWireMaster::NormalLevel);
-    if (result == OneWireMaster::Success)
+    // try the fastest rate first, a failed change leaves the link in an
+    // unknown state so detect again at 9600 before the next one
+    linkBaud = Baud9600bps;
+    for (size_t idx = 0; idx < (sizeof(candidates) / sizeof(candidates[0])); idx++)
     {
-        // check for correct mode
-        if (mode != MODSEL_COMMAND)
+        if (candidates[idx] <= maxBaud)
         {
-            mode = MODSEL_COMMAND;
-            sendpacket[sendlen++] = MODE_COMMAND;
+            if (changeBaud(candidates[idx]) == OneWireMaster::Success)
+            {
+                break;
+            }
+
+            result = detect();
+            if (result != OneWireMaster::Success)
+            {
+                break;
+            }
         }
+    }
+
+    return result;
+}
+
+OneWireMaster::CmdResult DS2480B::resync()
+{
+    const uint8_t lastSpeed = speed;
+    const BaudRate lastLinkBaud = linkBaud;
+
+    // reset the DS2480B back to 9600 and restore the link
+    OneWireMaster::CmdResult result = detect();
+    if (result == OneWireMaster::Success)
+    {
+        result = changeBaud(lastLinkBaud);
+    }
+
+    if ((result == OneWireMaster::Success) && (lastSpeed != speed))
+    {
+        uint8_t sendpacket[1];
+
+        // restore the DS2480 communication speed
+        speed = lastSpeed;
+        sendpacket[0] = CMD_COMM | FUNCTSEL_SEARCHOFF | speed;
+        result = writeCom(1, sendpacket);
+    }
+
+    return result;
+}
+
+OneWireMaster::CmdResult DS2480B::OWReset()
+{
+    // make sure normal level
+    OneWireMaster::CmdResult result = reserveQueue(2 + levelSendSize, 1 + levelResponseSize);
+    if (result == OneWireMaster::Success)
+    {
+        queueLevel(OneWireMaster::NormalLevel);
 
         // construct the command
-        sendpacket[sendlen++] = (uint8_t)(CMD_COMM | FUNCTSEL_RESET | speed);
+        queueMode(MODSEL_COMMAND);
+        queueSend((uint8_t)(CMD_COMM | FUNCTSEL_RESET | speed));
+        queueResponse(ResetResponse);
 
-        // flush the buffers
-        flushCom();
+        result = completeQueue();
+    }
 
-        // send the packet
-        result = writeCom(sendlen, sendpacket);
-        if (result == OneWireMaster::Success)
+    return result;
+}
+
+OneWireMaster::CmdResult DS2480B::OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel)
+{
+    // make sure normal level
+    OneWireMaster::CmdResult result = reserveQueue(2 + (2 * levelSendSize), 1 + (2 * levelResponseSize));
+    if (result == OneWireMaster::Success)
+    {
+        queueLevel(OneWireMaster::NormalLevel);
+
+        // construct the command
+        queueMode(MODSEL_COMMAND);
+        queueSend((uint8_t)(((sendRecvBit != 0) ? BITPOL_ONE : BITPOL_ZERO) | CMD_COMM | FUNCTSEL_BIT | speed));
+        const size_t responseIdx = queueResponse(AnyResponse);
+
+        if ((sendRecvBit == 0) && (afterLevel == OneWireMaster::NormalLevel))
+        {
+            // a written zero always reads back as zero
+            result = completeQueue();
+        }
+        else
         {
-            // read back the 1 byte response
-            result = readCom(1, readbuffer);
+            queueLevel(afterLevel);
+            result = sendQueue();
             if (result == OneWireMaster::Success)
             {
-                // make sure this byte looks like a reset byte
-                if (((readbuffer[0] & RB_RESET_MASK) == RB_PRESENCE) || ((readbuffer[0] & RB_RESET_MASK) == RB_ALARMPRESENCE))
+                // interpret the response
+                if (((responses[responseIdx] & 0xE0) == 0x80) && ((responses[responseIdx] & RB_BIT_MASK) == RB_BIT_ONE))
                 {
-                    result = OneWireMaster::Success;
+                    sendRecvBit = 1;
                 }
                 else
                 {
-                    result = OneWireMaster::OperationFailure;
+                    sendRecvBit = 0;
                 }
             }
         }
@@ -260,313 +344,330 @@ OneWireMaster::CmdResult DS2480B::OWReset()
     return result;
 }
 
-OneWireMaster::CmdResult DS2480B::OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel)
+OneWireMaster::CmdResult DS2480B::OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel)
 {
-    OneWireMaster::CmdResult result = OneWireMaster::OperationFailure;
-
-    uint8_t readbuffer[10], sendpacket[10];
-    uint8_t sendlen = 0;
-
     // make sure normal level
-    OWSetLevel(OneWireMaster::NormalLevel);
-
-    // check for correct mode
-    if (mode != MODSEL_COMMAND)
-    {
-        mode = MODSEL_COMMAND;
-        sendpacket[sendlen++] = MODE_COMMAND;
-    }
-
-    // construct the command
-    sendpacket[sendlen] = (sendRecvBit != 0) ? BITPOL_ONE : BITPOL_ZERO;
-    sendpacket[sendlen++] |= CMD_COMM | FUNCTSEL_BIT | speed;
-
-    // flush the buffers
-    flushCom();
-
-    // send the packet
-    result = writeCom(sendlen, sendpacket);
+    OneWireMaster::CmdResult result = reserveQueue(3 + (2 * levelSendSize), 1 + (2 * levelResponseSize));
     if (result == OneWireMaster::Success)
     {
-        // read back the response
-        result = readCom(1, readbuffer);
-        if (result == OneWireMaster::Success)
+        queueLevel(OneWireMaster::NormalLevel);
+        queueData(sendByte);
+        queueResponse(EchoResponse, sendByte);
+
+        if (afterLevel == OneWireMaster::NormalLevel)
         {
-            // interpret the response
-            if (((readbuffer[0] & 0xE0) == 0x80) && ((readbuffer[0] & RB_BIT_MASK) == RB_BIT_ONE))
-            {
-                sendRecvBit = 1;
-                result = OneWireMaster::Success;
-            }
-            else
-            {
-                sendRecvBit = 0;
-                result = OneWireMaster::Success;
-            }
+            result = completeQueue();
         }
         else
         {
-            result = OneWireMaster::CommunicationReadError;
+            // the pullup must be active when this returns
+            queueLevel(afterLevel);
+            result = sendQueue();
         }
     }
-    else
-    {
-        result = OneWireMaster::CommunicationWriteError;
-    }
 
+    return result;
+}
+
+OneWireMaster::CmdResult DS2480B::OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel)
+{
+    // make sure normal level
+    OneWireMaster::CmdResult result = reserveQueue(2 + (2 * levelSendSize), 1 + (2 * levelResponseSize));
     if (result == OneWireMaster::Success)
     {
-        result = OWSetLevel(afterLevel);
+        queueLevel(OneWireMaster::NormalLevel);
+        queueData(0xFF);
+        const size_t responseIdx = queueResponse(AnyResponse);
+        queueLevel(afterLevel);
+
+        result = sendQueue();
+        if (result == OneWireMaster::Success)
+        {
+            recvByte = responses[responseIdx];
+        }
     }
 
     return result;
 }
 
-OneWireMaster::CmdResult DS2480B::OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel)
+OneWireMaster::CmdResult DS2480B::OWSetSpeed(OWSpeed newSpeed)
 {
-    OneWireMaster::CmdResult result = OneWireMaster::OperationFailure;
-
-    uint8_t readbuffer[10], sendpacket[10];
-    uint8_t sendlen = 0;
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
 
-    // make sure normal level
-    OWSetLevel(OneWireMaster::NormalLevel);
+    // standard speed uses flexible timing so the line profile applies
+    const uint8_t newSpeedSel = ((newSpeed == OneWireMaster::OverdriveSpeed) ? SPEEDSEL_OD : SPEEDSEL_FLEX);
 
-    // check for correct mode
-    if (mode != MODSEL_DATA)
+    // check if change from current mode, the link baud rate is kept for both speeds
+    if (speed != newSpeedSel)
     {
-        mode = MODSEL_DATA;
-        sendpacket[sendlen++] = MODE_DATA;
-    }
+        result = reserveQueue(2, 0);
+        if (result == OneWireMaster::Success)
+        {
+            speed = newSpeedSel;
 
-    // add the byte to send
-    sendpacket[sendlen++] = sendByte;
+            // proceed to set the DS2480 communication speed
+            queueMode(MODSEL_COMMAND);
+            queueSend(CMD_COMM | FUNCTSEL_SEARCHOFF | speed);
 
-    // check for duplication of data that looks like COMMAND mode
-    if (sendByte == MODE_COMMAND)
-    {
-        sendpacket[sendlen++] = sendByte;
+            result = completeQueue();
+        }
     }
 
-    // flush the buffers
-    flushCom();
+    return result;
+}
 
-    // send the packet
-    result = writeCom(sendlen, sendpacket);
+OneWireMaster::CmdResult DS2480B::OWSetLevel(OWLevel newLevel)
+{
+    OneWireMaster::CmdResult result = reserveQueue(levelSendSize, levelResponseSize);
     if (result == OneWireMaster::Success)
     {
-        // read back the 1 byte response
-        result = readCom(1, readbuffer);
-        if ((result == OneWireMaster::Success) && (readbuffer[0] == sendByte))
+        queueLevel(newLevel);
+
+        if (newLevel == OneWireMaster::NormalLevel)
         {
-            result = OneWireMaster::Success;
+            result = completeQueue();
         }
         else
         {
-            result = OneWireMaster::CommunicationReadError;
+            // the pullup must be active when this returns
+            result = sendQueue();
         }
     }
-    else
-    {
-        result = OneWireMaster::CommunicationWriteError;
-    }
 
+    return result;
+}
+
+OneWireMaster::CmdResult DS2480B::OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies)
+{
+    // two bits per ROM bit, discrepancy flag then search path or chosen direction
+    uint8_t searchData[16];
+
+    // make sure normal level
+    OneWireMaster::CmdResult result = reserveQueue(levelSendSize + 2 + 1 + (sizeof(searchData) * 2) + 2, levelResponseSize + sizeof(searchData));
     if (result == OneWireMaster::Success)
     {
-        result = OWSetLevel(afterLevel);
+        queueLevel(OneWireMaster::NormalLevel);
+
+        // search mode on
+        queueMode(MODSEL_COMMAND);
+        queueSend((uint8_t)(CMD_COMM | FUNCTSEL_SEARCHON | speed));
+
+        // add the 16 bytes of the search with the path in the odd bits
+        std::memset(searchData, 0, sizeof(searchData));
+        for (size_t idx = 0; idx < 64; idx++)
+        {
+            if ((romBuf[idx / 8] & (1 << (idx % 8))) != 0)
+            {
+                searchData[(idx * 2 + 1) / 8] |= (1 << ((idx * 2 + 1) % 8));
+            }
+        }
+        const size_t responseIdx = queuedResponses;
+        for (size_t idx = 0; idx < sizeof(searchData); idx++)
+        {
+            queueData(searchData[idx]);
+            queueResponse(AnyResponse);
+        }
+
+        // search mode off
+        queueMode(MODSEL_COMMAND);
+        queueSend((uint8_t)(CMD_COMM | FUNCTSEL_SEARCHOFF | speed));
+
+        result = sendQueue();
+        if (result == OneWireMaster::Success)
+        {
+            // interpret the bit stream
+            const uint8_t * readbuffer = &responses[responseIdx];
+            for (size_t idx = 0; idx < 64; idx++)
+            {
+                const uint8_t bitMask = (1 << (idx % 8));
+
+                if ((readbuffer[(idx * 2 + 1) / 8] & (1 << ((idx * 2 + 1) % 8))) != 0)
+                {
+                    romBuf[idx / 8] |= bitMask;
+                }
+                else
+                {
+                    romBuf[idx / 8] &= ~bitMask;
+                }
+
+                if ((readbuffer[(idx * 2) / 8] & (1 << ((idx * 2) % 8))) != 0)
+                {
+                    discrepancies[idx / 8] |= bitMask;
+                }
+                else
+                {
+                    discrepancies[idx / 8] &= ~bitMask;
+                }
+            }
+        }
     }
 
     return result;
 }
 
-OneWireMaster::CmdResult DS2480B::OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel)
+OneWireMaster::CmdResult DS2480B::OWWriteBlock(const uint8_t *sendBuf, size_t sendLen)
 {
-    OneWireMaster::CmdResult result = OneWireMaster::OperationFailure;
+    return dataTransfer(false, sendBuf, sendLen, NULL, 0);
+}
 
-    uint8_t readbuffer[10], sendpacket[10];
-    uint8_t sendlen = 0;
+OneWireMaster::CmdResult DS2480B::OWReadBlock(uint8_t *recvBuf, size_t recvLen)
+{
+    return dataTransfer(false, NULL, 0, recvBuf, recvLen);
+}
 
-    // make sure normal level
-    OWSetLevel(OneWireMaster::NormalLevel);
+OneWireMaster::CmdResult DS2480B::OWTransaction(const OneWireTransaction & transaction)
+{
+    OneWireMaster::CmdResult result = dataTransfer(transaction.reset, transaction.writeBuf, transaction.writeLen, transaction.readBuf, transaction.readLen);
 
-    // check for correct mode
-    if (mode != MODSEL_DATA)
+    if (result == OneWireMaster::Success)
     {
-        mode = MODSEL_DATA;
-        sendpacket[sendlen++] = MODE_DATA;
+        result = OWSetLevel(transaction.afterLevel);
     }
 
-    // add the byte to send
-    sendpacket[sendlen++] = 0xFF;
-
-    // flush the buffers
-    flushCom();
+    // the delay starts when the transaction is on the bus
+    if ((result == OneWireMaster::Success) && (transaction.delayMs > 0))
+    {
+        result = sendQueue();
+    }
 
-    // send the packet
-    result = writeCom(sendlen, sendpacket);
     if (result == OneWireMaster::Success)
     {
-        // read back the 1 byte response
-        result = readCom(1, readbuffer);
-        if (result == OneWireMaster::Success)
-        {
-            recvByte = readbuffer[0];
-            result = OneWireMaster::Success;
-        }
-        else
-        {
-            result = OneWireMaster::CommunicationReadError;
-        }
+        result = OWTransactionDelay(transaction);
+    }
+
+    return result;
+}
+
+void DS2480B::beginBatch()
+{
+    batchDepth++;
+}
+
+OneWireMaster::CmdResult DS2480B::endBatch()
+{
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
+
+    if (batchDepth > 0)
+    {
+        batchDepth--;
     }
-    else
+    if (batchDepth == 0)
     {
-        result = OneWireMaster::CommunicationWriteError;
+        result = sendQueue();
     }
 
-    // an error occured so re-sync with DS2480B
+    return result;
+}
+
+OneWireMaster::CmdResult DS2480B::setLineProfile(const LineProfile & profile)
+{
+    OneWireMaster::CmdResult result = reserveQueue(5, 4);
     if (result == OneWireMaster::Success)
     {
-        result = OWSetLevel(afterLevel);
+        queueMode(MODSEL_COMMAND);
+        queueConfig(PARMSEL_SLEW | profile.slewRate);
+        queueConfig(PARMSEL_WRITE1LOW | profile.write1LowTime);
+        queueConfig(PARMSEL_SAMPLEOFFSET | profile.sampleOffset);
+        queueConfig(PARMSEL_ACTIVEPULLUPTIME | profile.activePullupTime);
+
+        // the timing applies from here on
+        result = sendQueue();
+        if (result == OneWireMaster::Success)
+        {
+            lineProfile = profile;
+        }
     }
 
     return result;
 }
 
-OneWireMaster::CmdResult DS2480B::OWSetSpeed(OWSpeed newSpeed)
+OneWireMaster::CmdResult DS2480B::calibrateLine(const RomId & romId, unsigned int trials)
 {
-    OneWireMaster::CmdResult result = OneWireMaster::OperationFailure;
+    Lock busLock(*this);
 
-    uint8_t sendpacket[5];
-    uint8_t sendlen = 0;
+    // the line profile only applies to the flexible timing used at
+    // standard speed, at overdrive every setting would seem reliable
+    if (speed != SPEEDSEL_FLEX)
+    {
+        return OneWireMaster::OperationFailure;
+    }
+
+    const LineProfile initialProfile = lineProfile;
+    LineProfile profile = initialProfile;
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
 
-    // check if change from current mode
-    if (((newSpeed == OneWireMaster::OverdriveSpeed) && (speed != SPEEDSEL_OD)) || 
-        ((newSpeed == OneWireMaster::StandardSpeed) && (speed != SPEEDSEL_STD))) 
+    // sweep slew rate, write 1 low time and sample offset in turn from
+    // the fastest to the most conservative value and keep the first one
+    // that reads the ROM ID without error
+    for (unsigned int parameter = 0; (parameter < 3) && (result == OneWireMaster::Success); parameter++)
     {
-        if (newSpeed == OneWireMaster::OverdriveSpeed) 
+        bool reliable = false;
+
+        for (uint8_t value = 0x00; (value <= 0x0E) && !reliable && (result == OneWireMaster::Success); value += 0x02)
         {
-            result = changeBaud(Baud115200bps);
-            if (result == OneWireMaster::Success) 
+            switch (parameter)
             {
-                speed = SPEEDSEL_OD;
+            case 0:
+                profile.slewRate = static_cast<SlewRate>(value);
+                break;
+
+            case 1:
+                profile.write1LowTime = static_cast<Write1LowTime>(value);
+                break;
+
+            default:
+                profile.sampleOffset = static_cast<SampleOffset>(value);
+                break;
             }
-        } 
-        else if (newSpeed == OneWireMaster::StandardSpeed) 
-        {
-            result = changeBaud(Baud9600bps);
-            if (result == OneWireMaster::Success) 
+
+            result = setLineProfile(profile);
+            if (result == OneWireMaster::Success)
             {
-                speed = SPEEDSEL_STD;
+                reliable = (lineErrors(romId, trials) == 0);
             }
         }
 
-        // if baud rate is set correctly then change DS2480 speed
-        if (result == OneWireMaster::Success) 
+        if ((result == OneWireMaster::Success) && !reliable)
         {
-            // check if correct mode
-            if (mode != MODSEL_COMMAND) 
-            {
-                mode = MODSEL_COMMAND;
-                sendpacket[sendlen++] = MODE_COMMAND;
-            }
-
-            // proceed to set the DS2480 communication speed
-            sendpacket[sendlen++] = CMD_COMM | FUNCTSEL_SEARCHOFF | speed;
-
-            // send the packet
-            result = writeCom(sendlen,sendpacket);
+            result = OneWireMaster::OperationFailure;
         }
     }
 
+    if (result != OneWireMaster::Success)
+    {
+        setLineProfile(initialProfile);
+    }
+
     return result;
 }
 
-OneWireMaster::CmdResult DS2480B::OWSetLevel(OWLevel newLevel)
+unsigned int DS2480B::lineErrors(const RomId & romId, unsigned int trials)
 {
-    OneWireMaster::CmdResult result = OneWireMaster::Success;
+    unsigned int errors = 0;
+    RomId::Buffer romBuf;
+    uint8_t discrepancies[RomId::Buffer::csize];
 
-    uint8_t sendpacket[10], readbuffer[10];
-    uint8_t sendlen = 0;
-
-    // check if need to change level
-    if (newLevel != level)
+    for (unsigned int trial = 0; trial < trials; trial++)
     {
-        // check for correct mode
-        if (mode != MODSEL_COMMAND)
+        // search along the path of the known device, every bit read and
+        // the CRC must match
+        romBuf = romId.buffer;
+        OneWireMaster::CmdResult result = OWReset();
+        if (result == OneWireMaster::Success)
         {
-            mode = MODSEL_COMMAND;
-            sendpacket[sendlen++] = MODE_COMMAND;
+            result = OWWriteByte(RomCommands::SearchRomCmd);
         }
-
-        // check if just putting back to normal
-        if (newLevel == OneWireMaster::NormalLevel)
+        if (result == OneWireMaster::Success)
         {
-            // stop pulse command
-            sendpacket[sendlen++] = MODE_STOP_PULSE;
-
-            // add the command to begin the pulse WITHOUT prime
-            sendpacket[sendlen++] = CMD_COMM | FUNCTSEL_CHMOD | SPEEDSEL_PULSE | BITPOL_5V | PRIME5V_FALSE;
-
-            // stop pulse command
-            sendpacket[sendlen++] = MODE_STOP_PULSE;
-
-            // flush the buffers
-            flushCom();
-
-            // send the packet
-            result = writeCom(sendlen, sendpacket);
-            if (result == OneWireMaster::Success)
-            {
-                // read back the 1 byte response
-                result = readCom(2, readbuffer);
-                if (result == OneWireMaster::Success)
-                {
-                    // check response byte
-                    if (((readbuffer[0] & 0xE0) == 0xE0) && ((readbuffer[1] & 0xE0) == 0xE0))
-                    {
-                        level = OneWireMaster::NormalLevel;
-                    }
-                    else
-                    {
-                        result = OneWireMaster::OperationFailure;
-                    }
-                }
-            }
+            result = OWSearchRom(romBuf.data(), discrepancies);
         }
-        // set new level
-        else
+        if ((result != OneWireMaster::Success) || (romBuf != romId.buffer))
         {
-            // set the SPUD time value
-            sendpacket[sendlen++] = CMD_CONFIG | PARMSEL_5VPULSE | PARMSET_infinite;
-            // add the command to begin the pulse
-            sendpacket[sendlen++] = CMD_COMM | FUNCTSEL_CHMOD | SPEEDSEL_PULSE | BITPOL_5V;
-
-            // flush the buffers
-            flushCom();
-
-            // send the packet
-            result = writeCom(sendlen, sendpacket);
-            if (result == OneWireMaster::Success)
-            {
-                // read back the 1 byte response from setting time limit
-                result = readCom(1, readbuffer);
-                if (result == OneWireMaster::Success)
-                {
-                    // check response byte
-                    if ((readbuffer[0] & 0x81) == 0)
-                    {
-                        level = newLevel;
-                    }
-                    else
-                    {
-                        result = OneWireMaster::OperationFailure;
-                    }
-                }
-            }
+            errors++;
         }
     }
 
-    return result;
+    return errors;
 }
 
 OneWireMaster::CmdResult DS2480B::detect()
@@ -576,9 +677,11 @@ OneWireMaster::CmdResult DS2480B::detect()
     uint8_t sendpacket[10], readbuffer[10];
     uint8_t sendlen = 0;
 
-    // reset modes
+    // reset modes and discard queued commands
     level = OneWireMaster::NormalLevel;
     mode = MODSEL_COMMAND;
+    queuedSendLen = 0;
+    queuedResponses = 0;
     baud = Baud9600bps;
     speed = SPEEDSEL_FLEX;
 
@@ -602,13 +705,11 @@ OneWireMaster::CmdResult DS2480B::detect()
         // delay to let line settle
         wait_ms(2);
 
-        // set the FLEX configuration parameters
-        // default PDSRC = 1.37Vus
-        sendpacket[sendlen++] = CMD_CONFIG | PARMSEL_SLEW | PARMSET_Slew1p37Vus;
-        // default W1LT = 10us
-        sendpacket[sendlen++] = CMD_CONFIG | PARMSEL_WRITE1LOW | PARMSET_Write10us;
-        // default DSO/WORT = 8us
-        sendpacket[sendlen++] = CMD_CONFIG | PARMSEL_SAMPLEOFFSET | PARMSET_SampOff8us;
+        // set the FLEX configuration parameters of the line profile
+        sendpacket[sendlen++] = CMD_CONFIG | PARMSEL_SLEW | lineProfile.slewRate;
+        sendpacket[sendlen++] = CMD_CONFIG | PARMSEL_WRITE1LOW | lineProfile.write1LowTime;
+        sendpacket[sendlen++] = CMD_CONFIG | PARMSEL_SAMPLEOFFSET | lineProfile.sampleOffset;
+        sendpacket[sendlen++] = CMD_CONFIG | PARMSEL_ACTIVEPULLUPTIME | lineProfile.activePullupTime;
 
         // construct the command to read the baud rate (to test command block)
         sendpacket[sendlen++] = CMD_CONFIG | PARMSEL_PARMREAD | (PARMSEL_BAUDRATE >> 3);
@@ -624,12 +725,12 @@ OneWireMaster::CmdResult DS2480B::detect()
         if (result == OneWireMaster::Success)
         {
             // read back the response
-            result = readCom(5, readbuffer);
+            result = readCom(sendlen, readbuffer);
             if (result == OneWireMaster::Success)
             {
                 // look at the baud rate and bit operation
                 // to see if the response makes sense
-                if (((readbuffer[3] & 0xF1) == 0x00) && ((readbuffer[3] & 0x0E) == baud) && ((readbuffer[4] & 0xF0) == 0x90) && ((readbuffer[4] & 0x0C) == baud))
+                if (((readbuffer[4] & 0xF1) == 0x00) && ((readbuffer[4] & 0x0E) == baud) && ((readbuffer[5] & 0xF0) == 0x90) && ((readbuffer[5] & 0x0C) == baud))
                 {
                     result = OneWireMaster::Success;
                 }
@@ -646,13 +747,14 @@ OneWireMaster::CmdResult DS2480B::detect()
 
 OneWireMaster::CmdResult DS2480B::changeBaud(BaudRate newBaud)
 {
-    OneWireMaster::CmdResult result = OneWireMaster::Success;
+    // queued commands go out at the current baud rate
+    OneWireMaster::CmdResult result = sendQueue();
 
     uint8_t readbuffer[5], sendpacket[5], sendpacket2[5];
     uint8_t sendlen = 0, sendlen2 = 0;
 
     //see if diffenent then current baud rate
-    if (baud != newBaud)
+    if ((result == OneWireMaster::Success) && (baud != newBaud))
     {
         // build the command packet
         // check for correct mode
@@ -698,6 +800,7 @@ OneWireMaster::CmdResult DS2480B::changeBaud(BaudRate newBaud)
                     // verify correct baud
                     if ((readbuffer[0] & 0x0E) == (sendpacket[sendlen - 1] & 0x0E))
                     {
+                        linkBaud = newBaud;
                         result = OneWireMaster::Success;
                     }
                     else
@@ -724,65 +827,343 @@ OneWireMaster::CmdResult DS2480B::changeBaud(BaudRate newBaud)
     return result;
 }
 
-OneWireMaster::CmdResult DS2480B::writeCom(size_t outlen, uint8_t *outbuf)
+OneWireMaster::CmdResult DS2480B::dataTransfer(bool reset, const uint8_t *sendBuf, size_t sendLen, uint8_t *recvBuf, size_t recvLen)
 {
-    OneWireMaster::CmdResult result = OneWireMaster::OperationFailure;
+    // bytes per queued chunk, a chunk always fits an empty queue
+    static const size_t maxChunkLen = 32;
+
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
 
-    mbed::Timer timer;
-    uint32_t timeout = calculateBitTimeout(baud) * outlen;
-    uint8_t idx = 0;
+    size_t chunkLen, responseIdx;
+    size_t dataIdx = 0, chunkStart;
+    const size_t dataLen = (sendLen + recvLen);
+    bool resetPending = reset;
+    bool levelPending = true;
 
-    timer.start();
-    do
+    while ((result == OneWireMaster::Success) && (levelPending || resetPending || (dataIdx < dataLen)))
     {
-        while ((idx < outlen) && serial.writeable())
+        chunkLen = std::min(dataLen - dataIdx, maxChunkLen);
+        result = reserveQueue(levelSendSize + 2 + 1 + (chunkLen * 2), levelResponseSize + 1 + chunkLen);
+        if (result != OneWireMaster::Success)
         {
-            serial.putc(outbuf[idx++]);
+            break;
         }
 
-    } while ((idx < outlen) && (static_cast<unsigned int>(timer.read_us()) < timeout));
-    
-    if (idx == outlen)
+        // make sure normal level
+        if (levelPending)
+        {
+            queueLevel(OneWireMaster::NormalLevel);
+            levelPending = false;
+        }
+
+        if (resetPending)
+        {
+            // construct the reset command
+            queueMode(MODSEL_COMMAND);
+            queueSend((uint8_t)(CMD_COMM | FUNCTSEL_RESET | speed));
+            queueResponse(ResetResponse);
+            resetPending = false;
+        }
+
+        // add the bytes to write followed by 0xFF for each byte to read
+        chunkStart = dataIdx;
+        responseIdx = queuedResponses;
+        for (; dataIdx < (chunkStart + chunkLen); dataIdx++)
+        {
+            if (dataIdx < sendLen)
+            {
+                queueData(sendBuf[dataIdx]);
+                queueResponse(EchoResponse, sendBuf[dataIdx]);
+            }
+            else
+            {
+                queueData(0xFF);
+                queueResponse(AnyResponse);
+            }
+        }
+
+        if (dataIdx > sendLen)
+        {
+            // the read bytes are needed now
+            result = sendQueue();
+            for (size_t idx = std::max(chunkStart, sendLen); (result == OneWireMaster::Success) && (idx < dataIdx); idx++)
+            {
+                recvBuf[idx - sendLen] = responses[responseIdx + (idx - chunkStart)];
+            }
+        }
+        else
+        {
+            result = completeQueue();
+        }
+    }
+
+    return result;
+}
+
+OneWireMaster::CmdResult DS2480B::reserveQueue(size_t sendLen, size_t responseLen)
+{
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
+
+    if (((queuedSendLen + sendLen) > queueSendSize) || ((queuedResponses + responseLen) > queueResponseSize))
     {
-        result = OneWireMaster::Success;
+        result = sendQueue();
     }
-    else
+
+    return result;
+}
+
+void DS2480B::queueMode(uint8_t newMode)
+{
+    // check for correct mode
+    if (mode != newMode)
     {
-        result = OneWireMaster::TimeoutError;
+        mode = newMode;
+        queueSend((newMode == MODSEL_COMMAND) ? MODE_COMMAND : MODE_DATA);
+    }
+}
+
+void DS2480B::queueData(uint8_t data)
+{
+    queueMode(MODSEL_DATA);
+    queueSend(data);
+
+    // check for duplication of data that looks like COMMAND mode
+    if (data == MODE_COMMAND)
+    {
+        queueSend(data);
+    }
+}
+
+size_t DS2480B::queueResponse(ResponseCheck check, uint8_t value)
+{
+    responseChecks[queuedResponses] = check;
+    responses[queuedResponses] = value;
+    return queuedResponses++;
+}
+
+void DS2480B::queueConfig(uint8_t parameter)
+{
+    // the response is the command with the config bit cleared
+    queueSend(CMD_CONFIG | parameter);
+    queueResponse(EchoResponse, parameter);
+}
+
+void DS2480B::queueLevel(OWLevel newLevel)
+{
+    // check if need to change level
+    if (newLevel != level)
+    {
+        queueMode(MODSEL_COMMAND);
+
+        // check if just putting back to normal
+        if (newLevel == OneWireMaster::NormalLevel)
+        {
+            // stop pulse command
+            queueSend(MODE_STOP_PULSE);
+
+            // add the command to begin the pulse WITHOUT prime
+            queueSend(CMD_COMM | FUNCTSEL_CHMOD | SPEEDSEL_PULSE | BITPOL_5V | PRIME5V_FALSE);
+
+            // stop pulse command
+            queueSend(MODE_STOP_PULSE);
+
+            // 2 byte response
+            queueResponse(NormalLevelResponse);
+            queueResponse(NormalLevelResponse);
+        }
+        // set new level
+        else
+        {
+            // set the SPUD time value
+            queueSend(CMD_CONFIG | PARMSEL_5VPULSE | PARMSET_infinite);
+            // add the command to begin the pulse
+            queueSend(CMD_COMM | FUNCTSEL_CHMOD | SPEEDSEL_PULSE | BITPOL_5V);
+
+            // 1 byte response from setting time limit
+            queueResponse(StrongLevelResponse);
+        }
+
+        level = newLevel;
+    }
+}
+
+OneWireMaster::CmdResult DS2480B::completeQueue()
+{
+    return ((batchDepth > 0) ? OneWireMaster::Success : sendQueue());
+}
+
+OneWireMaster::CmdResult DS2480B::sendQueue()
+{
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
+
+    if (queuedSendLen > 0)
+    {
+        // flush the buffers
+        flushCom();
+
+        // send the packet
+        result = writeCom(queuedSendLen, queuedSend);
+        if (result == OneWireMaster::Success)
+        {
+            // read back the responses of all queued commands
+            uint8_t expected[queueResponseSize];
+            std::memcpy(expected, responses, queuedResponses);
+            result = readCom(queuedResponses, responses);
+            
+            // complete each command in order, reporting the first failure
+            for (size_t idx = 0; (result == OneWireMaster::Success) && (idx < queuedResponses); idx++)
+            {
+                switch (responseChecks[idx])
+                {
+                case EchoResponse:
+                    if (responses[idx] != expected[idx])
+                    {
+                        result = OneWireMaster::CommunicationReadError;
+                    }
+                    break;
+
+                case ResetResponse:
+                    // make sure this byte looks like a reset byte
+                    if (((responses[idx] & RB_RESET_MASK) != RB_PRESENCE) && ((responses[idx] & RB_RESET_MASK) != RB_ALARMPRESENCE))
+                    {
+                        result = OneWireMaster::OperationFailure;
+                    }
+                    break;
+
+                case NormalLevelResponse:
+                    if ((responses[idx] & 0xE0) != 0xE0)
+                    {
+                        result = OneWireMaster::OperationFailure;
+                    }
+                    break;
+
+                case StrongLevelResponse:
+                    if ((responses[idx] & 0x81) != 0)
+                    {
+                        result = OneWireMaster::OperationFailure;
+                    }
+                    break;
+
+                case AnyResponse:
+                default:
+                    break;
+                }
+            }
+        }
+
+        queuedSendLen = 0;
+        queuedResponses = 0;
+
+        // a timeout means the DS2480B was reset or lost sync with the link,
+        // fail this operation but make the link usable for the next one
+        if (result == OneWireMaster::TimeoutError)
+        {
+            resync();
+        }
     }
 
     return result;
 }
 
-OneWireMaster::CmdResult DS2480B::readCom(size_t inlen, uint8_t *inbuf)
+OneWireMaster::CmdResult DS2480B::writeCom(size_t outlen, uint8_t *outbuf)
 {
-    OneWireMaster::CmdResult result;
-    mbed::Timer timer;
-    uint32_t num_bytes_read = 0;
-    uint32_t timeout = (calculateBitTimeout(baud) * inlen);
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
 
-    timer.start();
-    do
+    // discard a completion left by a timed out write
+    while (txSemaphore.wait(0) > 0);
+
+    if (outlen > 0)
     {
-        while ((num_bytes_read < inlen) && serial.readable())
+        txData = outbuf;
+        txRemaining = outlen;
+
+        // the transmit interrupt feeds the UART and signals when done
+        serial.attach(this, &DS2480B::txIrq, mbed::SerialBase::TxIrq);
+        if (txSemaphore.wait(timeoutMs(calculateBitTimeout(baud) * outlen)) <= 0)
         {
-            inbuf[num_bytes_read++] = serial.getc();
+            serial.attach(NULL, mbed::SerialBase::TxIrq);
+            txRemaining = 0;
+            result = OneWireMaster::TimeoutError;
         }
-    } while ((num_bytes_read < inlen) && (static_cast<unsigned int>(timer.read_us()) < timeout));
-    timer.stop();
+    }
 
-    if (num_bytes_read == inlen)
+    return result;
+}
+
+OneWireMaster::CmdResult DS2480B::readCom(size_t inlen, uint8_t *inbuf)
+{
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
+
+    // discard a signal left by a timed out read
+    while (rxSemaphore.wait(0) > 0);
+
+    // wait for the receive interrupt to buffer the whole response
+    rxWaitCount = inlen;
+    if (rxCount() >= inlen)
     {
-        result = OneWireMaster::Success;
+        rxWaitCount = 0;
     }
-    else
+    else if (rxSemaphore.wait(timeoutMs(calculateBitTimeout(baud) * inlen)) <= 0)
     {
+        rxWaitCount = 0;
         result = OneWireMaster::TimeoutError;
     }
 
+    if ((result == OneWireMaster::Success) && rxOverrun)
+    {
+        result = OneWireMaster::CommunicationReadError;
+    }
+
+    if (result == OneWireMaster::Success)
+    {
+        for (size_t idx = 0; idx < inlen; idx++)
+        {
+            inbuf[idx] = rxBuffer[rxTail % rxBufferSize];
+            rxTail = (rxTail + 1);
+        }
+    }
+
     return result;
 }
 
+void DS2480B::rxIrq()
+{
+    while (serial.readable())
+    {
+        const uint8_t data = serial.getc();
+        if (rxCount() < rxBufferSize)
+        {
+            rxBuffer[rxHead % rxBufferSize] = data;
+            rxHead = (rxHead + 1);
+        }
+        else
+        {
+            rxOverrun = true;
+        }
+    }
+
+    if ((rxWaitCount > 0) && (rxCount() >= rxWaitCount))
+    {
+        rxWaitCount = 0;
+        rxSemaphore.release();
+    }
+}
+
+void DS2480B::txIrq()
+{
+    while ((txRemaining > 0) && serial.writeable())
+    {
+        serial.putc(*txData++);
+        txRemaining = (txRemaining - 1);
+    }
+
+    if (txRemaining == 0)
+    {
+        serial.attach(NULL, mbed::SerialBase::TxIrq);
+        txSemaphore.release();
+    }
+}
+
 void DS2480B::breakCom()
 {
     // Switch to lower baud rate to ensure break is longer than 2 ms.
@@ -794,10 +1175,8 @@ void DS2480B::breakCom()
 void DS2480B::flushCom()
 {
     // Clear receive buffer.
-    while (serial.readable())
-    {
-        serial.getc();
-    }
+    rxTail = rxHead;
+    rxOverrun = false;
 
     /* No apparent way to clear transmit buffer.
      * From the example in AN192 (http://pdfserv.maximintegrated.com/en/an/AN192.pdf),
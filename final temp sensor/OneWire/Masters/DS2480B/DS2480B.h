@@ -33,12 +33,24 @@
 #ifndef OneWire_Masters_DS2480B
 #define OneWire_Masters_DS2480B
 
-#include "Serial.h"
+#include "RawSerial.h"
+#include "rtos/Semaphore.h"
 #include "Masters/OneWireMaster.h"
+#include "RomId/RomId.h"
 
 namespace OneWire
 {
     /// Serial to 1-Wire Line Driver
+    ///
+    /// The UART is interrupt driven. Received bytes are buffered by the
+    /// receive interrupt and transmission is fed by the transmit interrupt
+    /// while the calling thread blocks on a semaphore, so other threads run
+    /// during serial transfers.
+    ///
+    /// Commands are collected in a queue and sent as one packet whose
+    /// concatenated response is parsed to complete each of them. Without a
+    /// batch the queue is sent by every operation, see beginBatch() for
+    /// deferring operations that do not return data.
     class DS2480B : public OneWireMaster
     {
     public:
@@ -50,8 +62,78 @@ namespace OneWire
             Baud57600bps = 4, ///< 57600 bps
             Baud115200bps = 6 ///< 115200 bps
         };
+        
+        /// Pull down slew rate
+        enum SlewRate
+        {
+            Slew15Vus = 0x00, ///< 15 V/us
+            Slew2p2Vus = 0x02, ///< 2.2 V/us
+            Slew1p65Vus = 0x04, ///< 1.65 V/us
+            Slew1p37Vus = 0x06, ///< 1.37 V/us
+            Slew1p1Vus = 0x08, ///< 1.1 V/us
+            Slew0p83Vus = 0x0A, ///< 0.83 V/us
+            Slew0p7Vus = 0x0C, ///< 0.7 V/us
+            Slew0p55Vus = 0x0E ///< 0.55 V/us
+        };
+        
+        /// Write 1 low time
+        enum Write1LowTime
+        {
+            Write8us = 0x00, ///< 8 us
+            Write9us = 0x02, ///< 9 us
+            Write10us = 0x04, ///< 10 us
+            Write11us = 0x06, ///< 11 us
+            Write12us = 0x08, ///< 12 us
+            Write13us = 0x0A, ///< 13 us
+            Write14us = 0x0C, ///< 14 us
+            Write15us = 0x0E ///< 15 us
+        };
+        
+        /// Data sample offset and write 0 recovery time
+        enum SampleOffset
+        {
+            SampleOffset3us = 0x00, ///< 3 us
+            SampleOffset4us = 0x02, ///< 4 us
+            SampleOffset5us = 0x04, ///< 5 us
+            SampleOffset6us = 0x06, ///< 6 us
+            SampleOffset7us = 0x08, ///< 7 us
+            SampleOffset8us = 0x0A, ///< 8 us
+            SampleOffset9us = 0x0C, ///< 9 us
+            SampleOffset10us = 0x0E ///< 10 us
+        };
+        
+        /// Active pullup on time
+        enum ActivePullupTime
+        {
+            Pullup0p0us = 0x00, ///< 0 us
+            Pullup0p5us = 0x02, ///< 0.5 us
+            Pullup1p0us = 0x04, ///< 1 us
+            Pullup1p5us = 0x06, ///< 1.5 us
+            Pullup2p0us = 0x08, ///< 2 us
+            Pullup2p5us = 0x0A, ///< 2.5 us
+            Pullup3p0us = 0x0C, ///< 3 us
+            Pullup3p5us = 0x0E ///< 3.5 us
+        };
+        
+        /// Line timing used at standard speed, which runs in the flexible
+        /// speed mode of the DS2480B.
+        struct LineProfile
+        {
+            SlewRate slewRate;
+            Write1LowTime write1LowTime;
+            SampleOffset sampleOffset;
+            ActivePullupTime activePullupTime;
+            
+            /// Conservative timing for typical networks.
+            LineProfile() 
+                : slewRate(Slew1p37Vus), write1LowTime(Write10us), 
+                  sampleOffset(SampleOffset8us), activePullupTime(Pullup3p0us) { }
+        };
 
-        DS2480B(PinName tx, PinName rx);
+        /// @param maxBaud Fastest baud rate the host UART sustains, the
+        ///                fastest rate up to it that works is negotiated by
+        ///                OWInitMaster() and used for both 1-Wire speeds.
+        DS2480B(PinName tx, PinName rx, BaudRate maxBaud = Baud115200bps);
 
         virtual OneWireMaster::CmdResult OWInitMaster();
         virtual OneWireMaster::CmdResult OWReset();
@@ -61,18 +143,157 @@ namespace OneWire
         virtual OneWireMaster::CmdResult OWSetSpeed(OWSpeed newSpeed);
         virtual OneWireMaster::CmdResult OWSetLevel(OWLevel newLevel);
         
+        /// Resolve the ROM ID with the search accelerator in one serial
+        /// packet instead of three bit operations per ROM bit.
+        virtual OneWireMaster::CmdResult OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies);
+        
+        /// @{
+        /// Stream the block in data mode with one serial packet per 32 bytes
+        /// instead of one round trip per byte.
+        virtual OneWireMaster::CmdResult OWWriteBlock(const uint8_t *sendBuf, size_t sendLen);
+        virtual OneWireMaster::CmdResult OWReadBlock(uint8_t *recvBuf, size_t recvLen);
+        /// @}
+        
+        /// Send the reset and all data of a transaction in as few serial
+        /// packets as possible instead of one round trip per byte.
+        virtual OneWireMaster::CmdResult OWTransaction(const OneWireTransaction & transaction);
+        
         OneWireMaster::CmdResult detect();
         OneWireMaster::CmdResult changeBaud(BaudRate newBaud);
+        
+        /// Switch to the fastest working baud rate up to the maximum, after
+        /// detect() has reset the DS2480B to 9600.
+        OneWireMaster::CmdResult negotiateBaud();
+        
+        /// Reset the DS2480B with a break and restore the link baud rate
+        /// and 1-Wire speed. Done automatically after a response timeout.
+        OneWireMaster::CmdResult resync();
+        
+        /// Baud rate kept on the link.
+        BaudRate linkBaudRate() const { return linkBaud; }
+        
+        /// Line timing in use, also applied by detect().
+        const LineProfile & currentLineProfile() const { return lineProfile; }
+        
+        /// Configure the line timing.
+        OneWireMaster::CmdResult setLineProfile(const LineProfile & profile);
+        
+        /// Find the fastest reliable line timing for the network. Slew rate,
+        /// write 1 low time and sample offset are swept in turn from the
+        /// fastest to the most conservative value and the first value that
+        /// reads the ROM ID of a known device error free in all trials is
+        /// kept. The active pullup time is left as configured.
+        /// @param romId ROM ID of a device on the bus.
+        /// @param trials Search ROM passes per setting.
+        /// @note Only available at standard speed since the line profile
+        ///       does not apply at overdrive.
+        /// @returns OperationFailure if not at standard speed or if no
+        ///          setting was reliable, the previous profile is restored.
+        OneWireMaster::CmdResult calibrateLine(const RomId & romId, unsigned int trials = 16);
+        
+        /// Start a batch of operations. Until the matching endBatch(),
+        /// resets, writes and level changes to NormalLevel are queued and
+        /// return Success. They are sent together with the next operation
+        /// that returns data or sets a strong pullup, which reports the
+        /// first failure of the queued operations. Batches nest. The caller
+        /// holds the bus lock for the whole batch.
+        void beginBatch();
+        
+        /// End a batch and send the queued operations when the outermost
+        /// batch ends.
+        /// @returns First failure of the operations sent.
+        OneWireMaster::CmdResult endBatch();
 
     private:
+        /// Expected response of a queued command.
+        enum ResponseCheck
+        {
+            AnyResponse, ///< Data, not checked
+            EchoResponse, ///< Echo of a written byte
+            ResetResponse, ///< Presence detect
+            NormalLevelResponse, ///< End of a strong pullup
+            StrongLevelResponse ///< Strong pullup duration set
+        };
+        
+        /// @{
+        /// Worst case queue usage of a level change.
+        static const size_t levelSendSize = 4;
+        static const size_t levelResponseSize = 2;
+        /// @}
+        
+        /// Send the queue first if the given lengths do not fit.
+        OneWireMaster::CmdResult reserveQueue(size_t sendLen, size_t responseLen);
+        void queueSend(uint8_t data) { queuedSend[queuedSendLen++] = data; }
+        void queueMode(uint8_t newMode);
+        /// Queue a byte in data mode.
+        void queueData(uint8_t data);
+        /// @returns Index of the response after sendQueue().
+        size_t queueResponse(ResponseCheck check, uint8_t value = 0);
+        void queueLevel(OWLevel newLevel);
+        /// Queue a configuration parameter write.
+        void queueConfig(uint8_t parameter);
+        /// Send the queue unless a batch is active.
+        OneWireMaster::CmdResult completeQueue();
+        /// Send the queue and check all responses.
+        OneWireMaster::CmdResult sendQueue();
+        
+        /// Optional reset followed by the bytes to send and 0xFF for each
+        /// byte to receive, in data mode. Written bytes are checked against
+        /// their echo.
+        OneWireMaster::CmdResult dataTransfer(bool reset, const uint8_t *sendBuf, size_t sendLen, uint8_t *recvBuf, size_t recvLen);
         OneWireMaster::CmdResult writeCom(size_t outlen, uint8_t *outbuf);
         OneWireMaster::CmdResult readCom(size_t inlen, uint8_t *inbuf);
         void breakCom();
         void flushCom();
         void setComBaud(BaudRate new_baud);
+        
+        /// @{
+        /// UART interrupt handlers.
+        void rxIrq();
+        void txIrq();
+        /// @}
+        
+        /// Number of received bytes waiting in the buffer.
+        size_t rxCount() const { return (rxHead - rxTail); }
+
+        /// Search ROM passes along the path of a known device that failed.
+        unsigned int lineErrors(const RomId & romId, unsigned int trials);
+        
+        LineProfile lineProfile;
+
+        // Link baud rate
+        const BaudRate maxBaud;
+        BaudRate linkBaud;
 
         // COM interface
-        mbed::Serial serial;
+        mbed::RawSerial serial;
+        
+        // Receive buffer, a single producer single consumer ring written by
+        // rxIrq() at rxHead and read by the calling thread at rxTail. The
+        // indexes run freely and are taken modulo the size, which must be a
+        // power of two. Holds the response to the largest packet sent.
+        static const size_t rxBufferSize = 64;
+        uint8_t rxBuffer[rxBufferSize];
+        volatile size_t rxHead;
+        volatile size_t rxTail;
+        volatile size_t rxWaitCount; // bytes readCom() waits for, 0 if not waiting
+        volatile bool rxOverrun; // bytes lost since the last flush
+        rtos::Semaphore rxSemaphore;
+        
+        // Transmit state, the bytes not yet written by txIrq()
+        const uint8_t * volatile txData;
+        volatile size_t txRemaining;
+        rtos::Semaphore txSemaphore;
+
+        // Command queue
+        static const size_t queueSendSize = 96;
+        static const size_t queueResponseSize = 40;
+        unsigned int batchDepth;
+        uint8_t queuedSend[queueSendSize];
+        size_t queuedSendLen;
+        uint8_t responseChecks[queueResponseSize];
+        uint8_t responses[queueResponseSize]; // expected echo when queued, response after sendQueue()
+        size_t queuedResponses;
 
         // DS2480B state
         OWLevel level; // 1-Wire level
@@ -0,0 +1,149 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/DS248x/DS2482EightChannel/DS2482ChannelRomIterator.h"
+
+
+using OneWire::OneWireMaster;
+using OneWire::DS2482ChannelRomIterator;
+using namespace OneWire::RomCommands;
+
+
+//*********************************************************************
+DS2482ChannelRomIterator::DS2482ChannelRomIterator(DS2482EightChannel & master)
+: RandomAccessRomIterator(master), m_master(master), m_numDevices(0)
+{
+}
+
+
+//*********************************************************************
+OneWireMaster::CmdResult DS2482ChannelRomIterator::discover()
+{
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
+    
+    clear();
+    
+    for (uint8_t ch = 0; (ch < DS2482EightChannel::channels) && (result == OneWireMaster::Success); ch++)
+    {
+        result = m_master.selectChannel(ch);
+        if (result != OneWireMaster::Success)
+        {
+            break;
+        }
+        
+        SearchState searchState;
+        OneWireMaster::CmdResult searchResult = OWFirst(m_master, searchState);
+        while (searchResult == OneWireMaster::Success)
+        {
+            result = addDevice(searchState.romId, ch);
+            if ((result != OneWireMaster::Success) || searchState.last_device_flag)
+            {
+                break;
+            }
+            searchResult = OWNext(m_master, searchState);
+        }
+        
+        // An empty channel has no presence pulse
+        if ((searchResult != OneWireMaster::Success) && (searchResult != OneWireMaster::OperationFailure))
+        {
+            result = searchResult;
+        }
+    }
+    
+    return result;
+}
+
+
+//*********************************************************************
+OneWireMaster::CmdResult DS2482ChannelRomIterator::addDevice(const RomId & romId, uint8_t channel)
+{
+    if (channel >= DS2482EightChannel::channels)
+    {
+        return OneWireMaster::OperationFailure;
+    }
+    
+    for (size_t idx = 0; idx < m_numDevices; idx++)
+    {
+        if (m_devices[idx].romId == romId)
+        {
+            m_devices[idx].channel = channel;
+            return OneWireMaster::Success;
+        }
+    }
+    
+    if (m_numDevices >= maxDevices)
+    {
+        return OneWireMaster::OperationFailure;
+    }
+    
+    m_devices[m_numDevices].romId = romId;
+    m_devices[m_numDevices].channel = channel;
+    m_numDevices++;
+    
+    return OneWireMaster::Success;
+}
+
+
+//*********************************************************************
+bool DS2482ChannelRomIterator::findChannel(const RomId & romId, uint8_t & channel) const
+{
+    for (size_t idx = 0; idx < m_numDevices; idx++)
+    {
+        if (m_devices[idx].romId == romId)
+        {
+            channel = m_devices[idx].channel;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+
+//*********************************************************************
+OneWireMaster::CmdResult DS2482ChannelRomIterator::selectDevice(const RomId & romId)
+{
+    uint8_t ch;
+    
+    if (!findChannel(romId, ch))
+    {
+        return OneWireMaster::OperationFailure;
+    }
+    
+    OneWireMaster::CmdResult result = m_master.selectChannel(ch);
+    if (result == OneWireMaster::Success)
+    {
+        result = OWMatchRom(m_master, romId);
+    }
+    
+    return result;
+}
@@ -0,0 +1,105 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_DS2482_Channel_Rom_Iterator
+#define OneWire_Masters_DS2482_Channel_Rom_Iterator
+
+
+#include "Masters/DS248x/DS2482EightChannel/DS2482EightChannel.h"
+#include "RomId/RomIterator.h"
+#include "Utilities/array.h"
+
+
+namespace OneWire
+{
+    /// Iterator for the eight multidrop buses of a DS2482-800.
+    /// @details Keeps a map from ROM ID to channel so that slave drivers
+    /// sharing the iterator are selected on the right channel. The
+    /// channel is only switched when the device lives on a different
+    /// channel than the one last selected.
+    class DS2482ChannelRomIterator : public RandomAccessRomIterator
+    {
+    public:
+        /// Maximum number of devices kept in the map.
+        static const size_t maxDevices = 64;
+        
+        /// @param master DS2482-800 to use to issue ROM commands.
+        DS2482ChannelRomIterator(DS2482EightChannel & master);
+        
+        /// The DS2482-800 used to issue ROM commands.
+        DS2482EightChannel & channelMaster() const { return m_master; }
+        
+        /// Search every channel and rebuild the map from the devices found.
+        /// @returns OperationFailure if more than maxDevices were found.
+        OneWireMaster::CmdResult discover();
+        
+        /// Add a device on a known channel to the map.
+        /// @returns OperationFailure if the map is full or the channel is invalid.
+        OneWireMaster::CmdResult addDevice(const RomId & romId, uint8_t channel);
+        
+        /// Remove all devices from the map.
+        void clear() { m_numDevices = 0; }
+        
+        /// Number of devices in the map.
+        size_t numDevices() const { return m_numDevices; }
+        
+        /// @{
+        /// ROM ID and channel of a device in the map.
+        const RomId & romId(size_t idx) const { return m_devices[idx].romId; }
+        uint8_t channel(size_t idx) const { return m_devices[idx].channel; }
+        /// @}
+        
+        /// Look up the channel of a device.
+        /// @returns False if the device is not in the map.
+        bool findChannel(const RomId & romId, uint8_t & channel) const;
+        
+        /// Select a channel for channel wide commands such as selectAllDevices().
+        OneWireMaster::CmdResult selectChannel(uint8_t channel) { return m_master.selectChannel(channel); }
+        
+        /// Select the channel of the device followed by Match ROM.
+        /// @returns OperationFailure if the device is not in the map.
+        virtual OneWireMaster::CmdResult selectDevice(const RomId & romId);
+        
+    private:
+        struct Device
+        {
+            RomId romId;
+            uint8_t channel;
+        };
+        
+        DS2482EightChannel & m_master;
+        array<Device, maxDevices> m_devices;
+        size_t m_numDevices;
+    };
+}
+
+#endif /* OneWire_Masters_DS2482_Channel_Rom_Iterator */
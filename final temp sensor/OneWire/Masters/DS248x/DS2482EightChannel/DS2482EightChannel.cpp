@@ -38,16 +38,34 @@ using OneWire::DS2482EightChannel;
 
 
 //*********************************************************************
-DS2482EightChannel::DS2482EightChannel(mbed::I2C & i2c_bus, uint8_t adrs) : DS248x(i2c_bus, adrs)
+DS2482EightChannel::DS2482EightChannel(mbed::I2C & i2c_bus, uint8_t adrs)
+: DS248x(i2c_bus, adrs), m_channel(channels)
 {
 }
 
 
+//*********************************************************************
+OneWireMaster::CmdResult DS2482EightChannel::reset()
+{
+    OneWireMaster::CmdResult result = DS248x::reset();
+    
+    // A device reset selects channel 0
+    m_channel = ((result == OneWireMaster::Success) ? 0 : channels);
+    
+    return result;
+}
+
+
 //*********************************************************************
 OneWireMaster::CmdResult DS2482EightChannel::selectChannel(uint8_t channel)
 {
     OneWireMaster::CmdResult result;
     uint8_t ch, ch_read;
+    
+    if ((channel == m_channel) && (channel < channels))
+    {
+        return OneWireMaster::Success;
+    }
 
     // Channel Select (Case A)
     //   S AD,0 [A] CHSL [A] CC [A] Sr AD,1 [A] [RR] A\ P
@@ -92,7 +110,7 @@ OneWireMaster::CmdResult DS2482EightChannel::selectChannel(uint8_t channel)
         break;
     };
 
-    result = sendCommand(ChannelSelectCmd, ch);
+    result = sendCommand(ChannelSelectCmd, ch, true);
     if (result == OneWireMaster::Success)
     {
         result = readRegister(ChannelSelectReg, ch, true);
@@ -105,6 +123,8 @@ OneWireMaster::CmdResult DS2482EightChannel::selectChannel(uint8_t channel)
             }
         }
     }
+    
+    m_channel = (((result == OneWireMaster::Success) && (channel < channels)) ? channel : channels);
 
     return result;
 }
@@ -64,10 +64,29 @@ namespace OneWire
         DS2482EightChannel(mbed::I2C & i2c_bus, uint8_t adrs);
         
         
+        ///Number of 1-Wire channels
+        static const uint8_t channels = 8;
+        
+        
         /// Select the 1-Wire channel on a DS2482-800.
         /// @note DS2482-800 only
-        /// @param channel Channel number to select beginning at 1.
+        /// @details Selecting the channel that is already selected does
+        /// not access the device.
+        /// @param channel Channel number to select from 0 to 7.
         OneWireMaster::CmdResult selectChannel(uint8_t channel);
+        
+        
+        /// Channel selected by the last successful selectChannel(),
+        /// or channels if unknown.
+        uint8_t currentChannel() const { return m_channel; }
+        
+        
+        /// Performs a soft reset which also selects channel 0.
+        /// @note This is not a 1-Wire Reset.
+        virtual OneWireMaster::CmdResult reset();
+        
+    private:
+        uint8_t m_channel;
     };
 }
 
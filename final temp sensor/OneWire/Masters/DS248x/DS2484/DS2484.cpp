@@ -50,7 +50,7 @@ OneWireMaster::CmdResult DS2484::adjustOwPort(OwAdjustParam param, uint8_t val)
 
     control_byte = (((param & 0x0F) << 4) | (val & 0x0F));
 
-    result = sendCommand(AdjustOwPortCmd, control_byte);
+    result = sendCommand(AdjustOwPortCmd, control_byte, true);
     if (result != Success)
     {
         return result;
@@ -32,6 +32,8 @@
 
 #include "Masters/DS248x/DS248x.h"
 #include "I2C.h"
+#include "Timeout.h"
+#include "rtos/Semaphore.h"
 
 using OneWire::OneWireMaster;
 using OneWire::DS248x;
@@ -51,6 +53,36 @@ enum StatusBit
 
 static const int I2C_WRITE_OK = 0;
 static const int I2C_READ_OK = 0;
+static const int I2C_WRITE_ACK = 1;
+
+/// Nominal 1-Wire timing used to predict how long a command keeps the DS248x busy.
+/// @{
+static const unsigned int standardResetTimeUs = 1148;
+static const unsigned int standardSlotTimeUs = 69;
+static const unsigned int overdriveResetTimeUs = 146;
+static const unsigned int overdriveSlotTimeUs = 10;
+/// @}
+
+/// Commands expected to finish sooner than this are polled immediately with
+/// a repeated start. Longer commands release the I2C bus and sleep first,
+/// where the timer wake-up costs far less than the command time.
+static const unsigned int minSleepTimeUs = 100;
+
+/// Timer interrupt handler that ends sleepUs().
+static void releaseSemaphore(rtos::Semaphore * semaphore)
+{
+    semaphore->release();
+}
+
+/// Sleep for the given time yielding to other threads until a timer interrupt
+/// wakes this one, so waits under 1 ms do not spin.
+static void sleepUs(unsigned int timeUs)
+{
+    rtos::Semaphore wakeup(0);
+    mbed::Timeout timer;
+    timer.attach_us(mbed::callback(releaseSemaphore, &wakeup), timeUs);
+    wakeup.wait();
+}
 
 uint8_t DS248x::Config::readByte() const
 {
@@ -90,8 +122,15 @@ void DS248x::Config::reset()
 
 
 DS248x::DS248x(mbed::I2C & i2c_bus, uint8_t adrs):
-m_i2c_bus(i2c_bus), m_adrs(adrs)
+m_i2c_bus(i2c_bus), m_adrs(adrs), m_strongPullup(false), m_transactionOpen(false)
 {
+    resetPollCounters();
+}
+
+void DS248x::resetPollCounters()
+{
+    m_pollCounters.commands = 0;
+    m_pollCounters.polls = 0;
 }
 
 
@@ -122,7 +161,7 @@ OneWireMaster::CmdResult DS248x::reset(void)
     OneWireMaster::CmdResult result;
     uint8_t buf;
 
-    result = sendCommand(DeviceResetCmd);
+    result = sendCommand(DeviceResetCmd, true);
 
     if (result == OneWireMaster::Success)
     {
@@ -156,19 +195,19 @@ OneWireMaster::CmdResult DS248x::OWTriplet(SearchDirection & searchDirection, ui
     //  SS indicates byte containing search direction bit value in msbit
 
     OneWireMaster::CmdResult result;
-    result = sendCommand(OwTripletCmd, (uint8_t)((searchDirection == WriteOne) ? 0x80 : 0x00));
+    uint8_t status;
+    result = executeCommand(OwTripletCmd, (uint8_t)((searchDirection == WriteOne) ? 0x80 : 0x00), &status);
     if (result == OneWireMaster::Success)
     {
-        uint8_t status;
-        result = pollBusy(&status);
-        if (result == OneWireMaster::Success)
-        {
-            // check bit results in status byte
-            sbr = ((status & Status_SBR) == Status_SBR);
-            tsb = ((status & Status_TSB) == Status_TSB);
-            searchDirection = ((status & Status_DIR) == Status_DIR) ? WriteOne : WriteZero;
-        }
+        // check bit results in status byte
+        sbr = ((status & Status_SBR) == Status_SBR);
+        tsb = ((status & Status_TSB) == Status_TSB);
+        searchDirection = ((status & Status_DIR) == Status_DIR) ? WriteOne : WriteZero;
     }
+
+    // The 1-Wire command ended any strong pullup.
+    m_strongPullup = false;
+
     return result;
 }
 
@@ -183,12 +222,7 @@ OneWireMaster::CmdResult DS248x::OWReset()
     OneWireMaster::CmdResult result;
     uint8_t buf;
 
-    result = sendCommand(OwResetCmd);
-
-    if (result == OneWireMaster::Success)
-    {
-        result = pollBusy(&buf);
-    }
+    result = executeCommand(OwResetCmd, &buf);
 
     if (result == OneWireMaster::Success)
     {
@@ -199,6 +233,9 @@ OneWireMaster::CmdResult DS248x::OWReset()
         }
     }
 
+    // The 1-Wire command ended any strong pullup.
+    m_strongPullup = false;
+
     return result;
 }
 
@@ -221,16 +258,11 @@ OneWireMaster::CmdResult DS248x::OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLev
 
     uint8_t status;
 
-    result = sendCommand(OwSingleBitCmd, (uint8_t)(sendRecvBit ? 0x80 : 0x00));
-
-    if (result == OneWireMaster::Success)
-    {
-        result = pollBusy(&status);
-    }
+    result = executeCommand(OwSingleBitCmd, (uint8_t)(sendRecvBit ? 0x80 : 0x00), &status);
 
     if (result == OneWireMaster::Success)
     {
-        sendRecvBit = (status & Status_SBR);
+        sendRecvBit = ((status & Status_SBR) == Status_SBR);
     }
 
     return result;
@@ -253,11 +285,7 @@ OneWireMaster::CmdResult DS248x::OWWriteByteSetLevel(uint8_t sendByte, OWLevel a
         return result;
     }
 
-    result = sendCommand(OwWriteByteCmd, sendByte);
-    if (result == OneWireMaster::Success)
-    {
-        result = pollBusy();
-    }
+    result = executeCommand(OwWriteByteCmd, sendByte);
 
     return result;
 }
@@ -282,21 +310,84 @@ OneWireMaster::CmdResult DS248x::OWReadByteSetLevel(uint8_t & recvByte, OWLevel
         return result;
     }
 
-    result = sendCommand(OwReadByteCmd);
+    result = executeCommand(OwReadByteCmd, &buf, true);
 
     if (result == OneWireMaster::Success)
     {
-        result = pollBusy();
+        result = readData(buf, false);
     }
 
     if (result == OneWireMaster::Success)
     {
-        result = readRegister(ReadDataReg, buf);
+        recvByte = buf;
     }
 
-    if (result == OneWireMaster::Success)
+    return result;
+}
+
+OneWireMaster::CmdResult DS248x::OWReadBlock(uint8_t * recvBuf, size_t recvLen)
+{
+    // 1-Wire Read Bytes (Case C) chained for each byte
+    //   S AD,0 [A] 1WRB [A] Sr AD,1 [A] [Status] A [Status] A\ Sr
+    //   AD,0 [A] SRP [A] E1 [A] Sr AD,1 [A] DD A\ Sr
+    //   AD,0 [A] 1WRB [A] ... DD A\ P
+    //
+    //  [] indicates from slave
+    //  DD data read
+    //  Every 1-Wire command moves the read pointer back to the status
+    //  register, so only the data read sets it.
+
+    // The block runs as one I2C transaction only when no byte sleeps, so the
+    // I2C bus lock is never held across a sleep.
+    const bool batch = (busyTimeUs(OwReadByteCmd) < minSleepTimeUs);
+    if (batch)
     {
-        recvByte = buf;
+        m_i2c_bus.lock();
+    }
+    OneWireMaster::CmdResult result = configureLevel(NormalLevel);
+
+    for (size_t i = 0; (i < recvLen) && (result == OneWireMaster::Success); i++)
+    {
+        uint8_t status;
+        result = executeCommand(OwReadByteCmd, &status, true);
+        if (result == OneWireMaster::Success)
+        {
+            result = readData(recvBuf[i], ((i + 1) < recvLen));
+        }
+    }
+    if (batch)
+    {
+        m_i2c_bus.unlock();
+    }
+
+    return result;
+}
+
+OneWireMaster::CmdResult DS248x::OWWriteBlock(const uint8_t * sendBuf, size_t sendLen)
+{
+    // 1-Wire Write Byte (Case B) chained for each byte
+    //   S AD,0 [A] 1WWB [A] DD [A] Sr AD,1 [A] [Status] A [Status] A\ Sr
+    //   AD,0 [A] 1WWB [A] ... [Status] A\ P
+    //
+    //  [] indicates from slave
+    //  DD data to write
+
+    // The block runs as one I2C transaction only when no byte sleeps, so the
+    // I2C bus lock is never held across a sleep.
+    const bool batch = (busyTimeUs(OwWriteByteCmd) < minSleepTimeUs);
+    if (batch)
+    {
+        m_i2c_bus.lock();
+    }
+    OneWireMaster::CmdResult result = configureLevel(NormalLevel);
+
+    for (size_t i = 0; (i < sendLen) && (result == OneWireMaster::Success); i++)
+    {
+        result = executeCommand(OwWriteByteCmd, sendBuf[i], NULL, ((i + 1) < sendLen));
+    }
+    if (batch)
+    {
+        m_i2c_bus.unlock();
     }
 
     return result;
@@ -325,7 +416,18 @@ OneWireMaster::CmdResult DS248x::OWSetLevel(OWLevel newLevel)
         return OneWireMaster::OperationFailure;
     }
 
-    return configureLevel(newLevel);
+    if (!m_strongPullup)
+    {
+        return OneWireMaster::Success;
+    }
+
+    // End the strong pullup by writing the configuration with SPU cleared.
+    OneWireMaster::CmdResult result = sendCommand(WriteDeviceConfigCmd, m_curConfig.writeByte());
+    if (result == OneWireMaster::Success)
+    {
+        m_strongPullup = false;
+    }
+    return result;
 }
 
 OneWireMaster::CmdResult DS248x::writeConfig(const Config & config, bool verify)
@@ -333,13 +435,18 @@ OneWireMaster::CmdResult DS248x::writeConfig(const Config & config, bool verify)
     uint8_t configBuf;
     OneWireMaster::CmdResult result;
 
+    // Write Device Configuration (Case A)
+    //   S AD,0 [A] WCFG [A] CF [A] Sr AD,1 [A] [CF] A\ P
+    //  [] indicates from slave
+    //  CF configuration byte, read pointer is left on the configuration register
+
     configBuf = config.writeByte();
-    result = sendCommand(WriteDeviceConfigCmd, configBuf);
+    result = sendCommand(WriteDeviceConfigCmd, configBuf, verify);
     if (verify)
     {
         if (result == OneWireMaster::Success)
         {
-            result = readRegister(ConfigReg, configBuf);
+            result = readRegister(ConfigReg, configBuf, true);
         }
         if (result == OneWireMaster::Success)
         {
@@ -352,7 +459,11 @@ OneWireMaster::CmdResult DS248x::writeConfig(const Config & config, bool verify)
 
     if (result == OneWireMaster::Success)
     {
+        // SPU only arms the strong pullup for the next 1-Wire command and is
+        // cleared by the DS248x when that pullup ends.
         m_curConfig = config;
+        m_curConfig.setSPU(false);
+        m_strongPullup = config.getSPU();
     }
 
     return result;
@@ -363,87 +474,233 @@ OneWireMaster::CmdResult DS248x::readRegister(Register reg, uint8_t & buf, bool
     CmdResult result = Success;
     if (!skipSetPointer)
     {
-        result = sendCommand(SetReadPointerCmd, reg);
+        result = sendCommand(SetReadPointerCmd, reg, true);
     }
     if (result == Success)
     {
+        beginTransaction();
         if (m_i2c_bus.read(m_adrs, reinterpret_cast<char *>(&buf), 1) != I2C_READ_OK)
         {
             result = CommunicationReadError;
         }
+        endTransaction(false);
     }
     return result;
 }
 
-OneWireMaster::CmdResult DS248x::pollBusy(uint8_t * pStatus)
+OneWireMaster::CmdResult DS248x::readData(uint8_t & buf, bool repeated)
+{
+    //   Sr AD,0 [A] SRP [A] E1 [A] Sr AD,1 [A] DD A\ P
+    CmdResult result = sendCommand(SetReadPointerCmd, ReadDataReg, true);
+    if (result == Success)
+    {
+        if (m_i2c_bus.read(m_adrs, reinterpret_cast<char *>(&buf), 1, repeated) != I2C_READ_OK)
+        {
+            // A failed read ends with a stop.
+            repeated = false;
+            result = CommunicationReadError;
+        }
+        endTransaction(repeated);
+    }
+    return result;
+}
+
+OneWireMaster::CmdResult DS248x::pollBusy(uint8_t * pStatus, bool repeated)
 {
     const unsigned int pollLimit = 200;
 
-    OneWireMaster::CmdResult result;
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
     uint8_t status;
     unsigned int pollCount = 0;
 
+    // Sr AD,1 [A] [Status] A [Status] A\ P
+    // Status is read continuously in one transfer since the read pointer
+    // stays on the status register while the 1-Wire operation completes.
+    beginTransaction();
+    m_i2c_bus.start();
+    if (m_i2c_bus.write(m_adrs | 1) != I2C_WRITE_ACK)
+    {
+        m_i2c_bus.stop();
+        endTransaction(false);
+        return OneWireMaster::CommunicationReadError;
+    }
+
     do
     {
-        result = readRegister(StatusReg, status, true);
-        if (result != OneWireMaster::Success)
-        {
-            return result;
-        }
-        if (pStatus != NULL)
-        {
-            *pStatus = status;
-        }
+        status = m_i2c_bus.read(mbed::I2C::ACK);
+        m_pollCounters.polls++;
         if (pollCount++ >= pollLimit)
         {
-            return OneWireMaster::TimeoutError;
+            result = OneWireMaster::TimeoutError;
         }
-    } while (status & Status_1WB);
+    } while ((status & Status_1WB) && (result == OneWireMaster::Success));
 
-    return OneWireMaster::Success;
+    // The last byte of a read must be NACKed to release the bus.
+    status = m_i2c_bus.read(mbed::I2C::NoACK);
+    m_pollCounters.polls++;
+    // A timeout ends the transaction so the bus is not left open.
+    if (result != OneWireMaster::Success)
+    {
+        repeated = false;
+    }
+    if (!repeated)
+    {
+        m_i2c_bus.stop();
+    }
+    endTransaction(repeated);
+
+    if (pStatus != NULL)
+    {
+        *pStatus = status;
+    }
+
+    return result;
 }
 
-OneWireMaster::CmdResult DS248x::configureLevel(OWLevel level)
+unsigned int DS248x::busyTimeUs(Command cmd) const
 {
-    OneWireMaster::CmdResult result;
-    if (m_curConfig.getSPU() != (level == StrongLevel))
+    const bool overdrive = m_curConfig.get1WS();
+    const unsigned int slotTimeUs = (overdrive ? overdriveSlotTimeUs : standardSlotTimeUs);
+    unsigned int timeUs;
+    switch (cmd)
     {
-        Config newConfig = m_curConfig;
-        newConfig.setSPU(level == StrongLevel);
-        result = writeConfig(newConfig, true);
+    case OwResetCmd:
+        timeUs = (overdrive ? overdriveResetTimeUs : standardResetTimeUs);
+        break;
+
+    case OwWriteByteCmd:
+    case OwReadByteCmd:
+        timeUs = (8 * slotTimeUs);
+        break;
+
+    case OwTripletCmd:
+        timeUs = (3 * slotTimeUs);
+        break;
+
+    case OwSingleBitCmd:
+        timeUs = slotTimeUs;
+        break;
+
+    default:
+        timeUs = 0;
+        break;
     }
-    else
+    return timeUs;
+}
+
+OneWireMaster::CmdResult DS248x::executeCommand(Command cmd, uint8_t * pStatus, bool repeated)
+{
+    const unsigned int timeUs = busyTimeUs(cmd);
+    OneWireMaster::CmdResult result = sendCommand(cmd, (timeUs < minSleepTimeUs));
+    if (result == OneWireMaster::Success)
+    {
+        result = waitBusy(timeUs, pStatus, repeated);
+    }
+    return result;
+}
+
+OneWireMaster::CmdResult DS248x::executeCommand(Command cmd, uint8_t param, uint8_t * pStatus, bool repeated)
+{
+    const unsigned int timeUs = busyTimeUs(cmd);
+    OneWireMaster::CmdResult result = sendCommand(cmd, param, (timeUs < minSleepTimeUs));
+    if (result == OneWireMaster::Success)
     {
-        result = OneWireMaster::Success;
+        result = waitBusy(timeUs, pStatus, repeated);
     }
     return result;
 }
 
-OneWireMaster::CmdResult DS248x::sendCommand(Command cmd) const
+OneWireMaster::CmdResult DS248x::waitBusy(unsigned int timeUs, uint8_t * pStatus, bool repeated)
+{
+    m_pollCounters.commands++;
+    if (timeUs >= minSleepTimeUs)
+    {
+        // Never sleep inside an open transaction so other I2C users can use the bus.
+        if (m_transactionOpen)
+        {
+            m_i2c_bus.stop();
+            endTransaction(false);
+        }
+        sleepUs(timeUs);
+    }
+    return pollBusy(pStatus, repeated);
+}
+
+OneWireMaster::CmdResult DS248x::configureLevel(OWLevel level)
+{
+    // A normal level needs no configuration write since the next 1-Wire
+    // command ends any active strong pullup and the DS248x clears SPU itself.
+    OneWireMaster::CmdResult result = OneWireMaster::Success;
+    if (level == StrongLevel)
+    {
+        // Write Device Configuration (Case A) without verification
+        //   S AD,0 [A] WCFG [A] CF [A] Sr
+        //  The 1-Wire command follows with a repeated start.
+        Config newConfig = m_curConfig;
+        newConfig.setSPU(true);
+        result = sendCommand(WriteDeviceConfigCmd, newConfig.writeByte(), true);
+    }
+    m_strongPullup = ((level == StrongLevel) && (result == OneWireMaster::Success));
+    return result;
+}
+
+OneWireMaster::CmdResult DS248x::sendCommand(Command cmd, bool repeated) const
 {
     CmdResult result;
-    if (m_i2c_bus.write(m_adrs, reinterpret_cast<const char *>(&cmd), 1) == I2C_WRITE_OK)
+    beginTransaction();
+    if (m_i2c_bus.write(m_adrs, reinterpret_cast<const char *>(&cmd), 1, repeated) == I2C_WRITE_OK)
     {
         result = Success;
     }
     else
     {
+        if (repeated)
+        {
+            m_i2c_bus.stop();
+            repeated = false;
+        }
         result = CommunicationWriteError;
     }
+    endTransaction(repeated);
     return result;
 }
 
-OneWireMaster::CmdResult DS248x::sendCommand(Command cmd, uint8_t param) const
+OneWireMaster::CmdResult DS248x::sendCommand(Command cmd, uint8_t param, bool repeated) const
 {
     CmdResult result;
     uint8_t buf[2] = { cmd, param };
-    if (m_i2c_bus.write(m_adrs, reinterpret_cast<const char *>(buf), 2) == I2C_WRITE_OK)
+    beginTransaction();
+    if (m_i2c_bus.write(m_adrs, reinterpret_cast<const char *>(buf), 2, repeated) == I2C_WRITE_OK)
     {
         result = Success;
     }
     else
     {
+        if (repeated)
+        {
+            m_i2c_bus.stop();
+            repeated = false;
+        }
         result = CommunicationWriteError;
     }
+    endTransaction(repeated);
     return result;
 }
+
+void DS248x::beginTransaction() const
+{
+    if (!m_transactionOpen)
+    {
+        m_i2c_bus.lock();
+        m_transactionOpen = true;
+    }
+}
+
+void DS248x::endTransaction(bool repeated) const
+{
+    if (!repeated && m_transactionOpen)
+    {
+        m_transactionOpen = false;
+        m_i2c_bus.unlock();
+    }
+}
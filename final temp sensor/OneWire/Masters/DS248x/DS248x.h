@@ -96,13 +96,24 @@ namespace OneWire
         
         /// Performs a soft reset on the DS248x.
         /// @note This is note a 1-Wire Reset.
-        OneWireMaster::CmdResult reset(void);
+        virtual OneWireMaster::CmdResult reset(void);
 
         /// Write a new configuration to the DS248x.
         /// @param[in] config New configuration to write.
         /// @param verify Verify that the configuration was written successfully.
         OneWireMaster::CmdResult writeConfig(const Config & config, bool verify);
 
+        /// Status polling statistics. Commands counts the 1-Wire commands waited on,
+        /// polls counts every status register read while waiting.
+        struct PollCounters
+        {
+            uint32_t commands;
+            uint32_t polls;
+        };
+
+        const PollCounters & pollCounters() const { return m_pollCounters; }
+        void resetPollCounters();
+
         /// Read the current DS248x configuration.
         /// @returns The cached current configuration.
         Config currentConfig() const { return m_curConfig; }
@@ -127,6 +138,13 @@ namespace OneWire
         virtual OneWireMaster::CmdResult OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel);
         virtual OneWireMaster::CmdResult OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel);
         virtual OneWireMaster::CmdResult OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel);
+        
+        /// @note Chains the byte commands of the block in one I2C transaction where the
+        ///       expected 1-Wire time allows it.
+        virtual OneWireMaster::CmdResult OWReadBlock(uint8_t * recvBuf, size_t recvLen);
+        
+        /// @copydoc OWReadBlock
+        virtual OneWireMaster::CmdResult OWWriteBlock(const uint8_t * sendBuf, size_t sendLen);
         virtual OneWireMaster::CmdResult OWSetSpeed(OWSpeed newSpeed);
         virtual OneWireMaster::CmdResult OWSetLevel(OWLevel newLevel);
 
@@ -150,25 +168,65 @@ namespace OneWire
         /// @param adrs I2C bus address of the DS248x in mbed format.
         DS248x(mbed::I2C & i2c_bus, uint8_t adrs);
         
+        /// @param repeated Omit the stop condition so that a read can follow with a repeated start.
         /// @note Allow marking const since not public.
-        OneWireMaster::CmdResult sendCommand(Command cmd) const;
+        OneWireMaster::CmdResult sendCommand(Command cmd, bool repeated = false) const;
 
+        /// @param repeated Omit the stop condition so that a read can follow with a repeated start.
         /// @note Allow marking const since not public.
-        OneWireMaster::CmdResult sendCommand(Command cmd, uint8_t param) const;
+        OneWireMaster::CmdResult sendCommand(Command cmd, uint8_t param, bool repeated = false) const;
     
     private:
         /// Polls the DS248x status waiting for the 1-Wire Busy bit (1WB) to be cleared.
+        /// @details Status is read in a single I2C read transfer started with a
+        ///          repeated start after a command sent with sendCommand(..., true).
         /// @param[out] pStatus Optionally retrieve the status byte when 1WB cleared.
+        /// @param repeated Omit the stop condition so that another transfer can follow with a repeated start.
         /// @returns Success or TimeoutError if poll limit reached.
-        OneWireMaster::CmdResult pollBusy(uint8_t * pStatus = NULL);
+        OneWireMaster::CmdResult pollBusy(uint8_t * pStatus = NULL, bool repeated = false);
+
+        /// Send a 1-Wire command and wait for it to complete (Case B).
+        /// @details Commands expected to take a while release the I2C bus and sleep
+        ///          for the predicted time before polling. Short commands are polled
+        ///          immediately with a repeated start.
+        /// @param[out] pStatus Optionally retrieve the status byte when 1WB cleared.
+        /// @param repeated Omit the stop condition so that another transfer can follow with a repeated start.
+        OneWireMaster::CmdResult executeCommand(Command cmd, uint8_t * pStatus = NULL, bool repeated = false);
+
+        /// @copydoc executeCommand(Command, uint8_t *, bool)
+        OneWireMaster::CmdResult executeCommand(Command cmd, uint8_t param, uint8_t * pStatus = NULL, bool repeated = false);
+
+        /// Read the Read Data register after a Read Byte command (end of Case C).
+        /// @param[out] buf Data read.
+        /// @param repeated Omit the stop condition so that another command can follow with a repeated start.
+        OneWireMaster::CmdResult readData(uint8_t & buf, bool repeated);
+
+        /// Sleep for the predicted command time if worthwhile and then poll for completion.
+        /// @details The I2C transaction is ended before sleeping. Shorter waits poll
+        ///          with a repeated start while holding the I2C bus lock.
+        OneWireMaster::CmdResult waitBusy(unsigned int timeUs, uint8_t * pStatus, bool repeated);
 
-        /// Ensure that the desired 1-Wire level is set in the configuration.
-        /// @param level Desired 1-Wire level.
+        /// Expected time in microseconds that a command keeps the 1-Wire bus busy at the current speed.
+        unsigned int busyTimeUs(Command cmd) const;
+
+        /// Arm the strong pullup for the next 1-Wire command if a strong level is desired.
+        /// @param level Desired 1-Wire level after the next 1-Wire command.
         OneWireMaster::CmdResult configureLevel(OWLevel level);
+
+        /// Lock the I2C bus when a transaction starts so that other I2C users cannot
+        /// access the bus between transfers joined by repeated starts.
+        void beginTransaction() const;
+
+        /// Release the I2C bus lock once a transaction ends with a stop condition.
+        /// @param repeated Transaction continues with a repeated start.
+        void endTransaction(bool repeated) const;
         
         mbed::I2C & m_i2c_bus;
         uint8_t m_adrs;
         Config m_curConfig;
+        PollCounters m_pollCounters;
+        bool m_strongPullup;
+        mutable bool m_transactionOpen;
     };
 }
 
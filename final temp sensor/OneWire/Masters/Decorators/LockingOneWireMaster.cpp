@@ -0,0 +1,117 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Decorators/LockingOneWireMaster.h"
+
+using namespace OneWire;
+
+void LockingOneWireMaster::lock()
+{
+    m_mutex.lock();
+}
+
+void LockingOneWireMaster::unlock()
+{
+    m_mutex.unlock();
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWInitMaster()
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWInitMaster();
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWReset()
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWReset();
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWTouchBitSetLevel(sendRecvBit, afterLevel);
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWWriteByteSetLevel(sendByte, afterLevel);
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWReadByteSetLevel(recvByte, afterLevel);
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWWriteBlock(const uint8_t *sendBuf, size_t sendLen)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWWriteBlock(sendBuf, sendLen);
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWReadBlock(uint8_t *recvBuf, size_t recvLen)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWReadBlock(recvBuf, recvLen);
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWSetSpeed(OWSpeed newSpeed)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWSetSpeed(newSpeed);
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWSetLevel(OWLevel newLevel)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWSetLevel(newLevel);
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWTriplet(searchDirection, sbr, tsb);
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWSearchRom(romBuf, discrepancies);
+}
+
+OneWireMaster::CmdResult LockingOneWireMaster::OWTransaction(const OneWireTransaction & transaction)
+{
+    Lock busLock(*this);
+    return OneWireMasterDecorator::OWTransaction(transaction);
+}
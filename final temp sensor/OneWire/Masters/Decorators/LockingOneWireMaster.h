@@ -0,0 +1,79 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Decorators_LockingOneWireMaster
+#define OneWire_Masters_Decorators_LockingOneWireMaster
+
+#include "Masters/Decorators/OneWireMasterDecorator.h"
+#include "rtos/Mutex.h"
+
+namespace OneWire
+{
+    /// Decorator that makes a 1-Wire master safe to share between RTOS
+    /// threads. lock() and unlock() use a recursive mutex, and every
+    /// operation also holds it so that single operations are never
+    /// interleaved. Slave drivers and ROM commands hold a
+    /// OneWireMaster::Lock across each complete transaction, so driver
+    /// threads can use slaves on the same bus without a global mutex.
+    ///
+    /// Wrap the master once and give the LockingOneWireMaster to the
+    /// RomIterator of the bus. As without threads, a
+    /// MultidropRomIteratorWithResume must be shared by every driver on the
+    /// bus since it tracks the last selected device.
+    class LockingOneWireMaster : public OneWireMasterDecorator
+    {
+    public:
+        /// @param master 1-Wire master to share.
+        explicit LockingOneWireMaster(OneWireMaster & master) : OneWireMasterDecorator(master) { }
+        
+        virtual void lock();
+        virtual void unlock();
+        
+        virtual CmdResult OWInitMaster();
+        virtual CmdResult OWReset();
+        virtual CmdResult OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel);
+        virtual CmdResult OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel);
+        virtual CmdResult OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel);
+        virtual CmdResult OWWriteBlock(const uint8_t *sendBuf, size_t sendLen);
+        virtual CmdResult OWReadBlock(uint8_t *recvBuf, size_t recvLen);
+        virtual CmdResult OWSetSpeed(OWSpeed newSpeed);
+        virtual CmdResult OWSetLevel(OWLevel newLevel);
+        virtual CmdResult OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb);
+        virtual CmdResult OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies);
+        virtual CmdResult OWTransaction(const OneWireTransaction & transaction);
+        
+    private:
+        rtos::Mutex m_mutex;
+    };
+}
+
+#endif
@@ -0,0 +1,75 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Decorators_OneWireMasterDecorator
+#define OneWire_Masters_Decorators_OneWireMasterDecorator
+
+#include "Masters/OneWireMaster.h"
+#include "Masters/OneWireTransaction.h"
+
+namespace OneWire
+{
+    /// Base for 1-Wire masters that add behavior to another master. Every
+    /// operation is forwarded unchanged to the wrapped master, including the
+    /// block, triplet, search and transaction operations so that native
+    /// implementations are kept.
+    /// Derived classes override the operations they need to observe.
+    class OneWireMasterDecorator : public OneWireMaster
+    {
+    public:
+        /// @param master 1-Wire master to forward all operations to.
+        explicit OneWireMasterDecorator(OneWireMaster & master) : m_master(master) { }
+        
+        /// The wrapped 1-Wire master.
+        OneWireMaster & master() const { return m_master; }
+        
+        virtual void lock() { m_master.lock(); }
+        virtual void unlock() { m_master.unlock(); }
+        virtual CmdResult OWInitMaster() { return m_master.OWInitMaster(); }
+        virtual CmdResult OWReset() { return m_master.OWReset(); }
+        virtual CmdResult OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel) { return m_master.OWTouchBitSetLevel(sendRecvBit, afterLevel); }
+        virtual CmdResult OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel) { return m_master.OWWriteByteSetLevel(sendByte, afterLevel); }
+        virtual CmdResult OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel) { return m_master.OWReadByteSetLevel(recvByte, afterLevel); }
+        virtual CmdResult OWWriteBlock(const uint8_t *sendBuf, size_t sendLen) { return m_master.OWWriteBlock(sendBuf, sendLen); }
+        virtual CmdResult OWReadBlock(uint8_t *recvBuf, size_t recvLen) { return m_master.OWReadBlock(recvBuf, recvLen); }
+        virtual CmdResult OWSetSpeed(OWSpeed newSpeed) { return m_master.OWSetSpeed(newSpeed); }
+        virtual CmdResult OWSetLevel(OWLevel newLevel) { return m_master.OWSetLevel(newLevel); }
+        virtual CmdResult OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb) { return m_master.OWTriplet(searchDirection, sbr, tsb); }
+        virtual CmdResult OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies) { return m_master.OWSearchRom(romBuf, discrepancies); }
+        virtual CmdResult OWTransaction(const OneWireTransaction & transaction) { return m_master.OWTransaction(transaction); }
+        
+    private:
+        OneWireMaster & m_master;
+    };
+}
+
+#endif
@@ -0,0 +1,275 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Decorators/StatisticsOneWireMaster.h"
+#include "Masters/OneWireTransaction.h"
+#include "us_ticker_api.h"
+
+using namespace OneWire;
+
+const size_t StatisticsOneWireMaster::latencyBuckets;
+
+StatisticsOneWireMaster::StatisticsOneWireMaster(OneWireMaster & master)
+    : OneWireMasterDecorator(master), m_speed(StandardSpeed), m_level(NormalLevel)
+{
+    resetStatistics();
+}
+
+void StatisticsOneWireMaster::resetStatistics()
+{
+    m_counters.resets = 0;
+    m_counters.presenceFailures = 0;
+    m_counters.bytesWritten = 0;
+    m_counters.bytesRead = 0;
+    m_counters.bitsWritten = 0;
+    m_counters.bitsRead = 0;
+    m_counters.triplets = 0;
+    m_counters.searches = 0;
+    m_counters.transactions = 0;
+    m_counters.levelChanges = 0;
+    m_counters.speedChanges = 0;
+    m_counters.results.fill(0);
+    
+    for (size_t idx = 0; idx < m_latency.size(); idx++)
+    {
+        m_latency[idx].fill(0);
+    }
+}
+
+size_t StatisticsOneWireMaster::latencyBucket(uint32_t latencyUs)
+{
+    size_t bucket = 0;
+    
+    while ((latencyUs != 0) && (bucket < (latencyBuckets - 1)))
+    {
+        latencyUs >>= 1;
+        bucket++;
+    }
+    
+    return bucket;
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::record(Primitive primitive, uint32_t startUs, CmdResult result)
+{
+    m_latency[primitive][latencyBucket(us_ticker_read() - startUs)]++;
+    m_counters.results[result]++;
+    return result;
+}
+
+void StatisticsOneWireMaster::trackLevel(OWLevel newLevel)
+{
+    if (newLevel != m_level)
+    {
+        m_level = newLevel;
+        m_counters.levelChanges++;
+    }
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWInitMaster()
+{
+    const uint32_t startUs = us_ticker_read();
+    m_speed = StandardSpeed;
+    trackLevel(NormalLevel);
+    return record(InitMasterPrimitive, startUs, master().OWInitMaster());
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWReset()
+{
+    const uint32_t startUs = us_ticker_read();
+    const CmdResult result = master().OWReset();
+    
+    m_counters.resets++;
+    if (result == OperationFailure)
+    {
+        m_counters.presenceFailures++;
+    }
+    trackLevel(NormalLevel);
+    
+    return record(ResetPrimitive, startUs, result);
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel)
+{
+    const uint32_t startUs = us_ticker_read();
+    const bool readSlot = ((sendRecvBit & 0x01) == 0x01);
+    
+    trackLevel(NormalLevel);
+    trackLevel(afterLevel);
+    
+    const CmdResult result = master().OWTouchBitSetLevel(sendRecvBit, afterLevel);
+    if (result == Success)
+    {
+        if (readSlot)
+        {
+            m_counters.bitsRead++;
+        }
+        else
+        {
+            m_counters.bitsWritten++;
+        }
+    }
+    
+    return record(TouchBitPrimitive, startUs, result);
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel)
+{
+    const uint32_t startUs = us_ticker_read();
+    
+    trackLevel(NormalLevel);
+    trackLevel(afterLevel);
+    
+    const CmdResult result = master().OWWriteByteSetLevel(sendByte, afterLevel);
+    if (result == Success)
+    {
+        m_counters.bytesWritten++;
+    }
+    
+    return record(WriteBytePrimitive, startUs, result);
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel)
+{
+    const uint32_t startUs = us_ticker_read();
+    
+    trackLevel(NormalLevel);
+    trackLevel(afterLevel);
+    
+    const CmdResult result = master().OWReadByteSetLevel(recvByte, afterLevel);
+    if (result == Success)
+    {
+        m_counters.bytesRead++;
+    }
+    
+    return record(ReadBytePrimitive, startUs, result);
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWWriteBlock(const uint8_t *sendBuf, size_t sendLen)
+{
+    const uint32_t startUs = us_ticker_read();
+    
+    trackLevel(NormalLevel);
+    
+    const CmdResult result = master().OWWriteBlock(sendBuf, sendLen);
+    if (result == Success)
+    {
+        m_counters.bytesWritten += sendLen;
+    }
+    
+    return record(WriteBlockPrimitive, startUs, result);
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWReadBlock(uint8_t *recvBuf, size_t recvLen)
+{
+    const uint32_t startUs = us_ticker_read();
+    
+    trackLevel(NormalLevel);
+    
+    const CmdResult result = master().OWReadBlock(recvBuf, recvLen);
+    if (result == Success)
+    {
+        m_counters.bytesRead += recvLen;
+    }
+    
+    return record(ReadBlockPrimitive, startUs, result);
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWSetSpeed(OWSpeed newSpeed)
+{
+    const uint32_t startUs = us_ticker_read();
+    
+    if (newSpeed != m_speed)
+    {
+        m_speed = newSpeed;
+        m_counters.speedChanges++;
+    }
+    
+    return record(SetSpeedPrimitive, startUs, master().OWSetSpeed(newSpeed));
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWSetLevel(OWLevel newLevel)
+{
+    const uint32_t startUs = us_ticker_read();
+    trackLevel(newLevel);
+    return record(SetLevelPrimitive, startUs, master().OWSetLevel(newLevel));
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb)
+{
+    const uint32_t startUs = us_ticker_read();
+    
+    m_counters.triplets++;
+    trackLevel(NormalLevel);
+    
+    return record(TripletPrimitive, startUs, master().OWTriplet(searchDirection, sbr, tsb));
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies)
+{
+    const uint32_t startUs = us_ticker_read();
+    
+    m_counters.searches++;
+    trackLevel(NormalLevel);
+    
+    return record(SearchRomPrimitive, startUs, master().OWSearchRom(romBuf, discrepancies));
+}
+
+OneWireMaster::CmdResult StatisticsOneWireMaster::OWTransaction(const OneWireTransaction & transaction)
+{
+    const uint32_t startUs = us_ticker_read();
+    const CmdResult result = master().OWTransaction(transaction);
+    
+    m_counters.transactions++;
+    if (transaction.reset)
+    {
+        m_counters.resets++;
+        // A missing presence pulse fails the transaction as it does OWReset().
+        if (result == OperationFailure)
+        {
+            m_counters.presenceFailures++;
+        }
+    }
+    // Data is only counted when it is known to have moved, as for the other operations.
+    if (result == Success)
+    {
+        m_counters.bytesWritten += transaction.writeLen;
+        m_counters.bytesRead += transaction.readLen;
+    }
+    trackLevel(NormalLevel);
+    trackLevel(transaction.afterLevel);
+    if (transaction.delayMs > 0)
+    {
+        trackLevel(NormalLevel);
+    }
+    
+    return record(TransactionPrimitive, startUs, result);
+}
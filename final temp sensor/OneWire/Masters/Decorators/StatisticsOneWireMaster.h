@@ -0,0 +1,134 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Decorators_StatisticsOneWireMaster
+#define OneWire_Masters_Decorators_StatisticsOneWireMaster
+
+#include "Masters/Decorators/OneWireMasterDecorator.h"
+#include "Utilities/array.h"
+
+namespace OneWire
+{
+    /// Decorator that counts the traffic and measures the latency of every
+    /// operation on the wrapped master. Wrap a master only where statistics
+    /// are wanted, the wrapped master itself is not changed.
+    ///
+    /// A bit touch with 1 in the lsb is counted as a read and a touch with 0
+    /// as a write, the two are not distinguishable on the bus.
+    ///
+    /// Bytes and bits are only counted for operations that returned Success,
+    /// failed operations show up in the per-result counters instead.
+    class StatisticsOneWireMaster : public OneWireMasterDecorator
+    {
+    public:
+        /// Operations with a latency histogram.
+        enum Primitive
+        {
+            InitMasterPrimitive,
+            ResetPrimitive,
+            TouchBitPrimitive,
+            WriteBytePrimitive,
+            ReadBytePrimitive,
+            WriteBlockPrimitive,
+            ReadBlockPrimitive,
+            SetSpeedPrimitive,
+            SetLevelPrimitive,
+            TripletPrimitive,
+            SearchRomPrimitive,
+            TransactionPrimitive,
+            NumPrimitives
+        };
+        
+        /// Number of latency buckets. Bucket 0 holds latencies below 1 us and
+        /// bucket n holds latencies from 2^(n-1) to 2^n - 1 us, the last
+        /// bucket also holds everything longer.
+        static const size_t latencyBuckets = 24;
+        
+        typedef array<uint32_t, latencyBuckets> LatencyHistogram;
+        
+        struct Counters
+        {
+            uint32_t resets;
+            uint32_t presenceFailures;
+            uint32_t bytesWritten;
+            uint32_t bytesRead;
+            uint32_t bitsWritten;
+            uint32_t bitsRead;
+            uint32_t triplets;
+            uint32_t searches;
+            uint32_t transactions;
+            uint32_t levelChanges;
+            uint32_t speedChanges;
+            /// Number of operations that returned each CmdResult.
+            array<uint32_t, OperationFailure + 1> results;
+        };
+        
+        /// @param master 1-Wire master to collect statistics on.
+        explicit StatisticsOneWireMaster(OneWireMaster & master);
+        
+        const Counters & counters() const { return m_counters; }
+        const LatencyHistogram & latency(Primitive primitive) const { return m_latency[primitive]; }
+        
+        /// Clear all counters and histograms.
+        void resetStatistics();
+        
+        /// Histogram bucket for a latency in us.
+        static size_t latencyBucket(uint32_t latencyUs);
+        
+        virtual CmdResult OWInitMaster();
+        virtual CmdResult OWReset();
+        virtual CmdResult OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel);
+        virtual CmdResult OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel);
+        virtual CmdResult OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel);
+        virtual CmdResult OWWriteBlock(const uint8_t *sendBuf, size_t sendLen);
+        virtual CmdResult OWReadBlock(uint8_t *recvBuf, size_t recvLen);
+        virtual CmdResult OWSetSpeed(OWSpeed newSpeed);
+        virtual CmdResult OWSetLevel(OWLevel newLevel);
+        virtual CmdResult OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb);
+        virtual CmdResult OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies);
+        virtual CmdResult OWTransaction(const OneWireTransaction & transaction);
+        
+    private:
+        Counters m_counters;
+        array<LatencyHistogram, NumPrimitives> m_latency;
+        OWSpeed m_speed;
+        OWLevel m_level;
+        
+        /// Record the result and latency of an operation.
+        CmdResult record(Primitive primitive, uint32_t startUs, CmdResult result);
+        
+        /// Count a level change if the bus is not already at newLevel.
+        void trackLevel(OWLevel newLevel);
+    };
+}
+
+#endif
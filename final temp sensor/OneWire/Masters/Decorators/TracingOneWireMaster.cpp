@@ -0,0 +1,196 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Decorators/TracingOneWireMaster.h"
+#include "us_ticker_api.h"
+
+using namespace OneWire;
+
+const size_t TracingOneWireMaster::capacity;
+
+TracingOneWireMaster::TracingOneWireMaster(OneWireMaster & master)
+    : OneWireMasterDecorator(master), m_droppedEvents(0)
+{
+    
+}
+
+void TracingOneWireMaster::clear()
+{
+    m_events.clear();
+    m_droppedEvents = 0;
+}
+
+void TracingOneWireMaster::flush(Trace::Sink & sink)
+{
+    Trace::Writer writer(sink);
+    
+    writer.beginChunk(m_events.size(), m_droppedEvents, (m_events.empty() ? 0 : m_events.front().startUs));
+    for (size_t idx = 0; idx < m_events.size(); idx++)
+    {
+        writer.writeEvent(m_events[idx]);
+    }
+    
+    clear();
+}
+
+void TracingOneWireMaster::push(const Trace::Event & event)
+{
+    if (!m_events.push_back_overwrite(event))
+    {
+        m_droppedEvents++;
+    }
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::record(Trace::Opcode opcode, uint32_t startUs, CmdResult result, uint8_t arg, uint8_t data)
+{
+    Trace::Event event;
+    event.startUs = startUs;
+    event.durationUs = (us_ticker_read() - startUs);
+    event.opcode = opcode;
+    event.result = result;
+    event.arg = arg;
+    event.data = data;
+    event.blockStart = false;
+    push(event);
+    
+    return result;
+}
+
+void TracingOneWireMaster::recordBlock(Trace::Opcode opcode, uint32_t startUs, CmdResult result, const uint8_t * data, size_t dataLen)
+{
+    Trace::Event event;
+    event.startUs = startUs;
+    event.durationUs = (us_ticker_read() - startUs);
+    event.opcode = opcode;
+    event.result = result;
+    event.arg = 0;
+    
+    if (dataLen == 0)
+    {
+        // Keep the result of an empty block so that replay returns the same one
+        event.data = 0;
+        event.blockStart = false;
+        push(event);
+    }
+    
+    for (size_t idx = 0; idx < dataLen; idx++)
+    {
+        event.data = data[idx];
+        event.blockStart = (idx == 0);
+        push(event);
+        
+        // The whole block is charged to its first byte
+        event.durationUs = 0;
+    }
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWInitMaster()
+{
+    const uint32_t startUs = us_ticker_read();
+    return record(Trace::InitMasterOp, startUs, master().OWInitMaster());
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWReset()
+{
+    const uint32_t startUs = us_ticker_read();
+    return record(Trace::ResetOp, startUs, master().OWReset());
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel)
+{
+    const uint32_t startUs = us_ticker_read();
+    const uint8_t sendBit = (sendRecvBit & 0x01);
+    const CmdResult result = master().OWTouchBitSetLevel(sendRecvBit, afterLevel);
+    return record(Trace::TouchBitOp, startUs, result, afterLevel, (sendBit | ((sendRecvBit & 0x01) << 1)));
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel)
+{
+    const uint32_t startUs = us_ticker_read();
+    return record(Trace::WriteByteOp, startUs, master().OWWriteByteSetLevel(sendByte, afterLevel), afterLevel, sendByte);
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel)
+{
+    const uint32_t startUs = us_ticker_read();
+    const CmdResult result = master().OWReadByteSetLevel(recvByte, afterLevel);
+    return record(Trace::ReadByteOp, startUs, result, afterLevel, recvByte);
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWWriteBlock(const uint8_t *sendBuf, size_t sendLen)
+{
+    const uint32_t startUs = us_ticker_read();
+    const CmdResult result = master().OWWriteBlock(sendBuf, sendLen);
+    recordBlock(Trace::WriteBlockOp, startUs, result, sendBuf, sendLen);
+    return result;
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWReadBlock(uint8_t *recvBuf, size_t recvLen)
+{
+    const uint32_t startUs = us_ticker_read();
+    const CmdResult result = master().OWReadBlock(recvBuf, recvLen);
+    recordBlock(Trace::ReadBlockOp, startUs, result, recvBuf, recvLen);
+    return result;
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWSetSpeed(OWSpeed newSpeed)
+{
+    const uint32_t startUs = us_ticker_read();
+    return record(Trace::SetSpeedOp, startUs, master().OWSetSpeed(newSpeed), newSpeed);
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWSetLevel(OWLevel newLevel)
+{
+    const uint32_t startUs = us_ticker_read();
+    return record(Trace::SetLevelOp, startUs, master().OWSetLevel(newLevel), newLevel);
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb)
+{
+    const uint32_t startUs = us_ticker_read();
+    const uint8_t requestedDirection = searchDirection;
+    const CmdResult result = master().OWTriplet(searchDirection, sbr, tsb);
+    return record(Trace::TripletOp, startUs, result, requestedDirection,
+                  ((sbr & 0x01) | ((tsb & 0x01) << 1) | ((searchDirection & 0x01) << 2)));
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies)
+{
+    // Decompose into traced triplets
+    return OneWireMaster::OWSearchRom(romBuf, discrepancies);
+}
+
+OneWireMaster::CmdResult TracingOneWireMaster::OWTransaction(const OneWireTransaction & transaction)
+{
+    // Decompose through the traced primitives
+    return OneWireMaster::OWTransaction(transaction);
+}
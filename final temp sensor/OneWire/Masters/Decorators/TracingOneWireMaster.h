@@ -0,0 +1,96 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Decorators_TracingOneWireMaster
+#define OneWire_Masters_Decorators_TracingOneWireMaster
+
+#include "Masters/Decorators/OneWireMasterDecorator.h"
+#include "Masters/Trace/OneWireTrace.h"
+#include "Utilities/ring_buffer.h"
+
+namespace OneWire
+{
+    /// Decorator that records every operation on the wrapped master with its
+    /// start time, duration, result and data into a ring buffer. When the
+    /// buffer is full the oldest events are overwritten and counted as
+    /// dropped. flush() drains the buffer to a Trace::Sink in the stream
+    /// format of OneWireTrace.h, which ReplayOneWireMaster can play back.
+    /// Transactions and search passes are recorded as the primitive
+    /// operations they consist of so that a replay does not depend on the
+    /// native implementation.
+    class TracingOneWireMaster : public OneWireMasterDecorator
+    {
+    public:
+        /// Number of events held between flushes.
+        static const size_t capacity = 256;
+        
+        typedef ring_buffer<Trace::Event, capacity> EventBuffer;
+        
+        /// @param master 1-Wire master to trace.
+        explicit TracingOneWireMaster(OneWireMaster & master);
+        
+        /// Events recorded since the last flush, oldest first.
+        const EventBuffer & events() const { return m_events; }
+        
+        /// Events overwritten since the last flush.
+        uint32_t droppedEvents() const { return m_droppedEvents; }
+        
+        /// Write all recorded events to the sink as one chunk and clear the buffer.
+        void flush(Trace::Sink & sink);
+        
+        /// Discard all recorded events.
+        void clear();
+        
+        virtual CmdResult OWInitMaster();
+        virtual CmdResult OWReset();
+        virtual CmdResult OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel);
+        virtual CmdResult OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel);
+        virtual CmdResult OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel);
+        virtual CmdResult OWWriteBlock(const uint8_t *sendBuf, size_t sendLen);
+        virtual CmdResult OWReadBlock(uint8_t *recvBuf, size_t recvLen);
+        virtual CmdResult OWSetSpeed(OWSpeed newSpeed);
+        virtual CmdResult OWSetLevel(OWLevel newLevel);
+        virtual CmdResult OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb);
+        virtual CmdResult OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies);
+        virtual CmdResult OWTransaction(const OneWireTransaction & transaction);
+        
+    private:
+        EventBuffer m_events;
+        uint32_t m_droppedEvents;
+        
+        CmdResult record(Trace::Opcode opcode, uint32_t startUs, CmdResult result, uint8_t arg = 0, uint8_t data = 0);
+        void recordBlock(Trace::Opcode opcode, uint32_t startUs, CmdResult result, const uint8_t * data, size_t dataLen);
+        void push(const Trace::Event & event);
+    };
+}
+
+#endif
@@ -35,11 +35,18 @@
 #define ONEWIRE_MASTERS_H
 
 
+#include "Masters/BasicOneWireMaster.h"
+#include "Masters/OneWireTransaction.h"
 #include "Masters/DS248x/DS2484/DS2484.h"
 #include "Masters/DS248x/DS2482EightChannel/DS2482EightChannel.h"
+#include "Masters/DS248x/DS2482EightChannel/DS2482ChannelRomIterator.h"
 #include "Masters/DS248x/DS2482SingleChannel/DS2482SingleChannel.h"
 #include "Masters/DS2480B/DS2480B.h"
 #include "Masters/DS2465/DS2465.h"
+#include "Masters/Decorators/StatisticsOneWireMaster.h"
+#include "Masters/Decorators/TracingOneWireMaster.h"
+#include "Masters/Trace/ReplayOneWireMaster.h"
+#include "Masters/Decorators/LockingOneWireMaster.h"
 
 #if defined(TARGET_MAX32600)
     #include "Masters/TARGET_Maxim/TARGET_MAX32600/OwGpio/OwGpio.h"
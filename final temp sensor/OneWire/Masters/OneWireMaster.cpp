@@ -31,6 +31,9 @@
 **********************************************************************/
 
 #include "Masters/OneWireMaster.h"
+#include "Masters/BasicOneWireMaster.h"
+#include "Masters/OneWireTransaction.h"
+#include "wait_api.h"
 
 namespace OneWire
 {
@@ -90,4 +93,74 @@ namespace OneWire
         }
         return result;
     }
+
+    OneWireMaster::CmdResult OneWireMaster::OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies)
+    {
+        OneWireMasterRef master(*this);
+        return tripletSearchRom(master, romBuf, discrepancies);
+    }
+
+    OneWireMaster::CmdResult OneWireMaster::OWTransaction(const OneWireTransaction & transaction)
+    {
+        CmdResult result = Success;
+
+        if (transaction.reset)
+        {
+            result = OWReset();
+        }
+
+        // the level is changed with the last byte so a strong pullup follows it immediately
+        size_t writeBlockLen = ((transaction.readLen > 0) ? transaction.writeLen : (transaction.writeLen - 1));
+        if ((result == Success) && (transaction.writeLen > 0))
+        {
+            if (writeBlockLen > 0)
+            {
+                result = OWWriteBlock(transaction.writeBuf, writeBlockLen);
+            }
+            if ((result == Success) && (writeBlockLen < transaction.writeLen))
+            {
+                result = OWWriteByteSetLevel(transaction.writeBuf[writeBlockLen], transaction.afterLevel);
+            }
+        }
+
+        if ((result == Success) && (transaction.readLen > 0))
+        {
+            if (transaction.readLen > 1)
+            {
+                result = OWReadBlock(transaction.readBuf, transaction.readLen - 1);
+            }
+            if (result == Success)
+            {
+                result = OWReadByteSetLevel(transaction.readBuf[transaction.readLen - 1], transaction.afterLevel);
+            }
+        }
+
+        if ((result == Success) && (transaction.writeLen == 0) && (transaction.readLen == 0))
+        {
+            result = OWSetLevel(transaction.afterLevel);
+        }
+
+        if (result == Success)
+        {
+            result = OWTransactionDelay(transaction);
+        }
+
+        return result;
+    }
+
+    OneWireMaster::CmdResult OneWireMaster::OWTransactionDelay(const OneWireTransaction & transaction)
+    {
+        CmdResult result = Success;
+
+        if (transaction.delayMs > 0)
+        {
+            wait_ms(transaction.delayMs);
+            if (transaction.afterLevel != NormalLevel)
+            {
+                result = OWSetLevel(NormalLevel);
+            }
+        }
+
+        return result;
+    }
 }
@@ -38,6 +38,8 @@
 
 namespace OneWire
 {
+    struct OneWireTransaction;
+    
     /// Base class for all 1-Wire Masters.
     class OneWireMaster
     {
@@ -73,9 +75,33 @@ namespace OneWire
             OperationFailure
         };
 
+        /// Holds exclusive use of a 1-Wire master for the lifetime of the
+        /// object. Slave drivers take a Lock around each select + command +
+        /// data sequence so that threads sharing a bus do not interleave.
+        class Lock
+        {
+        public:
+            explicit Lock(OneWireMaster & master) : m_master(master) { m_master.lock(); }
+            ~Lock() { m_master.unlock(); }
+            
+        private:
+            OneWireMaster & m_master;
+            
+            Lock(const Lock &);
+            Lock & operator=(const Lock &);
+        };
+
         /// Allow freeing through a base class pointer.
         virtual ~OneWireMaster() { }
 
+        /// @{
+        /// Acquire and release exclusive use of the 1-Wire bus. Calls may be
+        /// nested by the same thread. The default implementation does nothing,
+        /// see LockingOneWireMaster for a thread-safe master.
+        virtual void lock() { }
+        virtual void unlock() { }
+        /// @}
+
         /// Initialize a master for use.
         virtual CmdResult OWInitMaster() = 0;
 
@@ -132,6 +158,33 @@ namespace OneWire
         **************************************************************/
         virtual CmdResult OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb);
 
+        /**********************************************************//**
+        * @brief Search ROM pass.
+        *
+        * @details Perform the 64 triplets of a Search ROM or Alarm
+        * Search after the search command has been sent. The default
+        * implementation issues OWTriplet() for each bit, masters with a
+        * search accelerator override it to resolve the whole ROM ID in
+        * one operation. Bits are numbered lsb first from the first byte.
+        *
+        * @param[in,out] romBuf
+        * Input with the 8 byte search path, each bit the direction to
+        * take in case both read bits are zero. Output with the ROM ID
+        * taken.
+        *
+        * @param[out] discrepancies 8 bytes with a bit set for each bit
+        * where both read bits were zero.
+        *
+        * @returns OperationFailure if no device responded.
+        **************************************************************/
+        virtual CmdResult OWSearchRom(uint8_t * romBuf, uint8_t * discrepancies);
+
+        /// Execute a complete transaction, see OneWireTransaction. The default
+        /// implementation issues the individual operations, masters that can
+        /// pipeline override it to execute the transaction as a unit.
+        /// @param[in] transaction Transaction to execute.
+        virtual CmdResult OWTransaction(const OneWireTransaction & transaction);
+
         /// Send one bit of communication and set a new level on the 1-Wire bus.
         /// @param sendBit Buffer containing the bit to send on 1-Wire bus in lsb.
         /// @param afterLevel Level to set the 1-Wire bus to after communication.
@@ -151,6 +204,11 @@ namespace OneWire
         CmdResult OWReadByte(uint8_t & recvByte) { return OWReadByteSetLevel(recvByte, NormalLevel); }
         CmdResult OWWriteBytePower(uint8_t sendByte) { return OWWriteByteSetLevel(sendByte, StrongLevel); }
         CmdResult OWReadBytePower(uint8_t & recvByte) { return OWReadByteSetLevel(recvByte, StrongLevel); }
+
+    protected:
+        /// Hold the level set by a transaction for its delay and return to
+        /// NormalLevel, for use by OWTransaction() implementations.
+        CmdResult OWTransactionDelay(const OneWireTransaction & transaction);
     };
 }
 
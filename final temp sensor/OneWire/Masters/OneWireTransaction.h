@@ -0,0 +1,76 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_OneWireTransaction
+#define OneWire_Masters_OneWireTransaction
+
+#include "Masters/OneWireMaster.h"
+
+namespace OneWire
+{
+    /// Descriptor of a complete 1-Wire transaction: an optional reset, bytes
+    /// to write, bytes to read and the bus level to leave after the last
+    /// byte. Masters that can pipeline execute it as a unit through
+    /// OneWireMaster::OWTransaction(), others fall back to the individual
+    /// operations. The buffers are not copied and must stay valid for the
+    /// call.
+    struct OneWireTransaction
+    {
+        /// Issue a 1-Wire reset first, OperationFailure if no presence pulse.
+        bool reset;
+        
+        /// @{
+        /// Bytes written after the reset.
+        const uint8_t * writeBuf;
+        size_t writeLen;
+        /// @}
+        
+        /// @{
+        /// Bytes read after the written bytes.
+        uint8_t * readBuf;
+        size_t readLen;
+        /// @}
+        
+        /// Level set after the last byte, StrongLevel for a strong pullup.
+        OneWireMaster::OWLevel afterLevel;
+        
+        /// Time in ms to hold afterLevel before returning to NormalLevel.
+        /// With 0 the bus is left at afterLevel for the caller to release.
+        unsigned int delayMs;
+        
+        OneWireTransaction()
+            : reset(false), writeBuf(NULL), writeLen(0), readBuf(NULL), readLen(0),
+              afterLevel(OneWireMaster::NormalLevel), delayMs(0) { }
+    };
+}
+
+#endif
@@ -0,0 +1,204 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Simulated/Devices/SimulatedDS18B20.h"
+#include "Utilities/crc.h"
+
+using namespace OneWire;
+using namespace OneWire::crc;
+
+enum DS18B20_CMDS
+{
+    WRITE_SCRATCHPAD = 0x4E,
+    READ_SCRATCHPAD = 0xBE,
+    COPY_SCRATCHPAD = 0x48,
+    CONV_TEMPERATURE = 0x44,
+    READ_POWER_SUPPY = 0xB4,
+    RECALL = 0xB8
+};
+
+static const int16_t powerOnTemperature = 0x0550;
+static const uint64_t copyTimeNs = 10000000;
+
+SimulatedDS18B20::SimulatedDS18B20(const RomId & romId, bool parasitePower)
+    : SimulatedSlave(romId, false, false), m_temperature(0x0190), m_parasitePower(parasitePower),
+      m_operation(NoOperation), m_busyUntilNs(0), m_pullupApplied(false), m_brownout(false), m_writeIndex(0),
+      m_conversions(0), m_brownouts(0)
+{
+    // Factory EEPROM: TH, TL and twelve bit resolution
+    m_eeprom[0] = 0x4B;
+    m_eeprom[1] = 0x46;
+    m_eeprom[2] = 0x7F;
+    
+    m_scratchpad[0] = static_cast<uint8_t>(powerOnTemperature);
+    m_scratchpad[1] = static_cast<uint8_t>(powerOnTemperature >> 8);
+    m_scratchpad[2] = m_eeprom[0];
+    m_scratchpad[3] = m_eeprom[1];
+    m_scratchpad[4] = m_eeprom[2];
+    m_scratchpad[5] = 0xFF;
+    m_scratchpad[6] = 0x0C;
+    m_scratchpad[7] = 0x10;
+}
+
+void SimulatedDS18B20::update()
+{
+    if ((m_operation == ConvertOperation) && !busy())
+    {
+        int16_t result = m_temperature;
+        
+        if (m_parasitePower && (m_brownout || !m_pullupApplied))
+        {
+            result = powerOnTemperature;
+            m_brownouts++;
+        }
+        else
+        {
+            // Lower resolutions leave the low bits undefined, model them as zero
+            unsigned int undefinedBits = (3 - ((m_scratchpad[4] >> 5) & 0x03));
+            result &= ~((1 << undefinedBits) - 1);
+        }
+        
+        m_scratchpad[0] = static_cast<uint8_t>(result);
+        m_scratchpad[1] = static_cast<uint8_t>(result >> 8);
+        m_conversions++;
+        m_operation = NoOperation;
+    }
+    else if ((m_operation == CopyOperation) && !busy())
+    {
+        m_operation = NoOperation;
+    }
+}
+
+void SimulatedDS18B20::busLevel(OneWireMaster::OWLevel level)
+{
+    if ((m_operation == ConvertOperation) && busy())
+    {
+        if (level == OneWireMaster::StrongLevel)
+        {
+            m_pullupApplied = true;
+        }
+        else
+        {
+            m_brownout = true;
+        }
+    }
+    update();
+}
+
+void SimulatedDS18B20::functionCommand(uint8_t command)
+{
+    update();
+    
+    switch (command)
+    {
+    case WRITE_SCRATCHPAD:
+        m_writeIndex = 0;
+        receiveBytes();
+        break;
+        
+    case READ_SCRATCHPAD:
+        transmitBytes(m_scratchpad, sizeof(m_scratchpad));
+        transmitByte(calculateCrc8(m_scratchpad, sizeof(m_scratchpad)));
+        break;
+        
+    case COPY_SCRATCHPAD:
+        m_eeprom[0] = m_scratchpad[2];
+        m_eeprom[1] = m_scratchpad[3];
+        m_eeprom[2] = m_scratchpad[4];
+        m_operation = CopyOperation;
+        m_busyUntilNs = (nowNs() + copyTimeNs);
+        transmitStatusBits();
+        break;
+        
+    case CONV_TEMPERATURE:
+        {
+            static const uint32_t conversionTimeUs[] = { 93750, 187500, 375000, 750000 };
+            m_operation = ConvertOperation;
+            m_busyUntilNs = (nowNs() + (static_cast<uint64_t>(conversionTimeUs[(m_scratchpad[4] >> 5) & 0x03]) * 1000));
+            m_pullupApplied = false;
+            m_brownout = false;
+            transmitStatusBits();
+        }
+        break;
+        
+    case READ_POWER_SUPPY:
+        m_operation = PowerSupplyOperation;
+        transmitStatusBits();
+        break;
+        
+    case RECALL:
+        m_scratchpad[2] = m_eeprom[0];
+        m_scratchpad[3] = m_eeprom[1];
+        m_scratchpad[4] = m_eeprom[2];
+        transmitStatusBits();
+        break;
+        
+    default:
+        waitForReset();
+        break;
+    }
+}
+
+void SimulatedDS18B20::receivedByte(uint8_t data)
+{
+    if (m_writeIndex < 3)
+    {
+        // Only the resolution bits of the configuration register are writable
+        m_scratchpad[2 + m_writeIndex] = ((m_writeIndex == 2) ? ((data & 0x60) | 0x1F) : data);
+        m_writeIndex++;
+    }
+}
+
+uint8_t SimulatedDS18B20::statusBit()
+{
+    uint8_t outBit = 1;
+    
+    update();
+    
+    if (m_operation == PowerSupplyOperation)
+    {
+        outBit = (m_parasitePower ? 0 : 1);
+    }
+    else if (busy())
+    {
+        // A parasite powered device cannot signal while it converts
+        outBit = ((m_parasitePower && (m_operation == ConvertOperation)) ? 1 : 0);
+    }
+    
+    return outBit;
+}
+
+bool SimulatedDS18B20::alarmed() const
+{
+    int16_t wholeDegrees = static_cast<int16_t>(static_cast<int16_t>((m_scratchpad[1] << 8) | m_scratchpad[0]) >> 4);
+    return ((wholeDegrees > static_cast<int8_t>(m_scratchpad[2])) || (wholeDegrees < static_cast<int8_t>(m_scratchpad[3])));
+}
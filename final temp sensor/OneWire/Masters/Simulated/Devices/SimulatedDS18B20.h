@@ -0,0 +1,100 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Simulated_SimulatedDS18B20
+#define OneWire_Masters_Simulated_SimulatedDS18B20
+
+#include "Masters/Simulated/SimulatedSlave.h"
+
+namespace OneWire
+{
+    /// Model of a DS18B20 thermometer. A conversion latches the temperature set
+    /// with setTemperature() after the conversion time of the configured
+    /// resolution. A parasite powered device only completes a conversion if
+    /// the strong pullup is held for the whole conversion, otherwise it reads
+    /// the 85 degC power-on value.
+    class SimulatedDS18B20 : public SimulatedSlave
+    {
+    public:
+        static const uint8_t familyCode = 0x28;
+        
+        /// @param romId ROM ID of the device.
+        /// @param parasitePower True if the device has no local supply.
+        SimulatedDS18B20(const RomId & romId, bool parasitePower = false);
+        
+        /// Temperature in 1/16 degC measured by the next conversion.
+        void setTemperature(int16_t temperature) { m_temperature = temperature; }
+        
+        bool parasitePower() const { return m_parasitePower; }
+        
+        /// Number of conversions completed, including failed ones.
+        uint32_t conversions() const { return m_conversions; }
+        
+        /// Number of parasite conversions that lost power.
+        uint32_t brownouts() const { return m_brownouts; }
+        
+        virtual void busLevel(OneWireMaster::OWLevel level);
+        
+    protected:
+        virtual void functionCommand(uint8_t command);
+        virtual void receivedByte(uint8_t data);
+        virtual uint8_t statusBit();
+        virtual bool alarmed() const;
+        
+    private:
+        enum Operation
+        {
+            NoOperation,
+            ConvertOperation,
+            CopyOperation,
+            PowerSupplyOperation
+        };
+        
+        uint8_t m_scratchpad[8];
+        uint8_t m_eeprom[3];
+        int16_t m_temperature;
+        bool m_parasitePower;
+        
+        Operation m_operation;
+        uint64_t m_busyUntilNs;
+        bool m_pullupApplied;
+        bool m_brownout;
+        size_t m_writeIndex;
+        uint32_t m_conversions;
+        uint32_t m_brownouts;
+        
+        void update();
+        bool busy() const { return (nowNs() < m_busyUntilNs); }
+    };
+}
+
+#endif
@@ -0,0 +1,111 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Simulated/Devices/SimulatedDS2413.h"
+
+using namespace OneWire;
+
+enum DS2413_CMDS
+{
+    PIO_ACCESS_READ = 0xF5,
+    PIO_ACCESS_WRITE = 0x5A
+};
+
+static const uint8_t writeConfirmation = 0xAA;
+
+SimulatedDS2413::SimulatedDS2413(const RomId & romId)
+    : SimulatedSlave(romId, true, true), m_latches(0x03), m_inputs(0x03), m_command(0), m_writeData(0),
+      m_writeDataValid(false)
+{
+}
+
+uint8_t SimulatedDS2413::pioStatus() const
+{
+    uint8_t pins = (m_latches & m_inputs);
+    uint8_t status = ((pins & 0x01) | ((m_latches & 0x01) << 1) | ((pins & 0x02) << 1) | ((m_latches & 0x02) << 2));
+    return static_cast<uint8_t>(((~status & 0x0F) << 4) | status);
+}
+
+void SimulatedDS2413::functionCommand(uint8_t command)
+{
+    m_command = command;
+    
+    switch (command)
+    {
+    case PIO_ACCESS_READ:
+        transmitByte(pioStatus());
+        break;
+        
+    case PIO_ACCESS_WRITE:
+        m_writeDataValid = false;
+        receiveBytes();
+        break;
+        
+    default:
+        waitForReset();
+        break;
+    }
+}
+
+void SimulatedDS2413::receivedByte(uint8_t data)
+{
+    if (!m_writeDataValid)
+    {
+        m_writeData = data;
+        m_writeDataValid = true;
+    }
+    else if (data == static_cast<uint8_t>(~m_writeData))
+    {
+        m_latches = (m_writeData & 0x03);
+        m_writeDataValid = false;
+        transmitByte(writeConfirmation);
+        transmitByte(pioStatus());
+    }
+    else
+    {
+        waitForReset();
+    }
+}
+
+void SimulatedDS2413::transmitComplete()
+{
+    if (m_command == PIO_ACCESS_READ)
+    {
+        // Status is sampled again for every byte read
+        transmitByte(pioStatus());
+    }
+    else
+    {
+        // Ready for the next write data pair
+        receiveBytes();
+    }
+}
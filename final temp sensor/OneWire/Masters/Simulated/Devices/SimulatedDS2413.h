@@ -0,0 +1,71 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Simulated_SimulatedDS2413
+#define OneWire_Masters_Simulated_SimulatedDS2413
+
+#include "Masters/Simulated/SimulatedSlave.h"
+
+namespace OneWire
+{
+    /// Model of a DS2413 dual channel addressable switch. Each PIO pin reads
+    /// low if its output latch is off or the external input pulls it low.
+    class SimulatedDS2413 : public SimulatedSlave
+    {
+    public:
+        static const uint8_t familyCode = 0x3A;
+        
+        explicit SimulatedDS2413(const RomId & romId);
+        
+        /// Output latch states, bit 0 is PIOA and bit 1 is PIOB.
+        uint8_t latches() const { return m_latches; }
+        
+        /// External levels applied to the pins, bit 0 is PIOA and bit 1 is PIOB.
+        void setExternalInputs(uint8_t inputs) { m_inputs = inputs; }
+        
+    protected:
+        virtual void functionCommand(uint8_t command);
+        virtual void receivedByte(uint8_t data);
+        virtual void transmitComplete();
+        
+    private:
+        uint8_t m_latches;
+        uint8_t m_inputs;
+        uint8_t m_command;
+        uint8_t m_writeData;
+        bool m_writeDataValid;
+        
+        uint8_t pioStatus() const;
+    };
+}
+
+#endif
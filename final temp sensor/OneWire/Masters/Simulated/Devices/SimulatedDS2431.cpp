@@ -0,0 +1,172 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Simulated/Devices/SimulatedDS2431.h"
+#include <cstring>
+
+using namespace OneWire;
+
+enum Command
+{
+    WriteScratchpad = 0x0F,
+    ReadScratchpad = 0xAA,
+    CopyScratchpad = 0x55,
+    ReadMemory = 0xF0
+};
+
+static const uint8_t authorizationAccepted = 0x80;
+static const uint8_t partialFlag = 0x20;
+static const uint8_t copyComplete = 0xAA;
+
+SimulatedDS2431::SimulatedDS2431(const RomId & romId)
+    : SimulatedSlave(romId, true, true), m_targetAddress(0), m_esByte(0), m_command(0), m_rxLen(0)
+{
+    std::memset(m_memory, 0xFF, sizeof(m_memory));
+    std::memset(m_scratchpad, 0xFF, sizeof(m_scratchpad));
+}
+
+void SimulatedDS2431::functionCommand(uint8_t command)
+{
+    m_command = command;
+    m_rxBuffer[0] = command;
+    m_rxLen = 1;
+    
+    switch (command)
+    {
+    case WriteScratchpad:
+    case CopyScratchpad:
+    case ReadMemory:
+        receiveBytes();
+        break;
+        
+    case ReadScratchpad:
+        {
+            uint8_t sendBlock[1 + 3 + 8];
+            size_t sendLen = 0;
+            sendBlock[sendLen++] = ReadScratchpad;
+            sendBlock[sendLen++] = static_cast<uint8_t>(m_targetAddress);
+            sendBlock[sendLen++] = static_cast<uint8_t>(m_targetAddress >> 8);
+            sendBlock[sendLen++] = m_esByte;
+            for (size_t idx = (m_targetAddress & 0x07); idx <= (m_esByte & 0x07U); idx++)
+            {
+                sendBlock[sendLen++] = m_scratchpad[idx];
+            }
+            transmitBytes(&sendBlock[1], sendLen - 1);
+            transmitInvertedCrc16(sendBlock, sendLen);
+        }
+        break;
+        
+    default:
+        waitForReset();
+        break;
+    }
+}
+
+void SimulatedDS2431::receivedByte(uint8_t data)
+{
+    if (m_rxLen < sizeof(m_rxBuffer))
+    {
+        m_rxBuffer[m_rxLen++] = data;
+    }
+    
+    if (m_rxLen < 3)
+    {
+        return;
+    }
+    
+    uint16_t address = static_cast<uint16_t>(m_rxBuffer[1] | (m_rxBuffer[2] << 8));
+    
+    switch (m_command)
+    {
+    case WriteScratchpad:
+        if (m_rxLen == 3)
+        {
+            m_targetAddress = address;
+            m_esByte = static_cast<uint8_t>((m_targetAddress & 0x07) | partialFlag);
+        }
+        else
+        {
+            size_t offset = ((m_targetAddress & 0x07) + (m_rxLen - 4));
+            m_scratchpad[offset] = data;
+            m_esByte = static_cast<uint8_t>(offset);
+            if (offset == 7)
+            {
+                // Row is complete, answer with the CRC of the whole command
+                transmitInvertedCrc16(m_rxBuffer, m_rxLen);
+            }
+            else
+            {
+                m_esByte |= partialFlag;
+            }
+        }
+        break;
+        
+    case CopyScratchpad:
+        if (m_rxLen == 4)
+        {
+            if ((address == m_targetAddress) && (data == m_esByte) && ((m_targetAddress + 8U) <= memorySize))
+            {
+                std::memcpy(&m_memory[m_targetAddress & ~0x07], m_scratchpad, sizeof(m_scratchpad));
+                m_esByte |= authorizationAccepted;
+                transmitByte(copyComplete);
+            }
+            else
+            {
+                waitForReset();
+            }
+        }
+        break;
+        
+    case ReadMemory:
+        if (address < memorySize)
+        {
+            transmitBytes(&m_memory[address], memorySize - address);
+        }
+        else
+        {
+            waitForReset();
+        }
+        break;
+        
+    default:
+        break;
+    }
+}
+
+void SimulatedDS2431::transmitComplete()
+{
+    if ((m_command == CopyScratchpad) && (m_esByte & authorizationAccepted))
+    {
+        // Alternating 1s and 0s until reset
+        transmitByte(copyComplete);
+    }
+}
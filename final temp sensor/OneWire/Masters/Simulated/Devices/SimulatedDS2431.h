@@ -0,0 +1,71 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Simulated_SimulatedDS2431
+#define OneWire_Masters_Simulated_SimulatedDS2431
+
+#include "Masters/Simulated/SimulatedSlave.h"
+
+namespace OneWire
+{
+    /// Model of a DS2431 1024-bit EEPROM. Implements Write/Read/Copy Scratchpad
+    /// and Read Memory. Copies are programmed as soon as the authorization
+    /// pattern has been received.
+    class SimulatedDS2431 : public SimulatedSlave
+    {
+    public:
+        static const uint8_t familyCode = 0x2D;
+        static const size_t memorySize = 0x90;
+        
+        explicit SimulatedDS2431(const RomId & romId);
+        
+        /// Direct access to the memory array, including the control area.
+        uint8_t * memory() { return m_memory; }
+        
+    protected:
+        virtual void functionCommand(uint8_t command);
+        virtual void receivedByte(uint8_t data);
+        virtual void transmitComplete();
+        
+    private:
+        uint8_t m_memory[memorySize];
+        uint8_t m_scratchpad[8];
+        uint16_t m_targetAddress;
+        uint8_t m_esByte;
+        
+        uint8_t m_command;
+        uint8_t m_rxBuffer[3 + 8];
+        size_t m_rxLen;
+    };
+}
+
+#endif
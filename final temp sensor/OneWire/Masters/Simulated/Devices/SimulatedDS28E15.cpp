@@ -0,0 +1,286 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Simulated/Devices/SimulatedDS28E15.h"
+
+using namespace OneWire;
+
+enum Command
+{
+    ReadMemory = 0xF0,
+    LoadAndLockSecret = 0x33,
+    ComputeAndLockSecret = 0x3C,
+    ReadWriteScratchpad = 0x0F,
+    ComputePageMac = 0xA5,
+    ReadStatus = 0xAA
+};
+
+static const uint8_t lockFlag = 0xE0;
+static const uint8_t successCs = 0xAA;
+static const uint8_t failureCs = 0x55;
+
+SimulatedDS28E15::SimulatedDS28E15(const RomId & romId, uint8_t manIdLsb, uint8_t manIdMsb)
+    : SimulatedSlave(romId, true, true), m_command(0), m_parameter(0), m_phase(ParameterPhase), m_dataIndex(0),
+      m_readPage(0)
+{
+    for (size_t idx = 0; idx < memoryPages; idx++)
+    {
+        m_pages[idx].fill(0x00);
+    }
+    m_scratchpad.fill(0x00);
+    m_secret.fill(0x00);
+    
+    m_personality[0] = 0x00;
+    m_personality[1] = 0x00;
+    m_personality[2] = manIdLsb;
+    m_personality[3] = manIdMsb;
+    
+    for (size_t idx = 0; idx < protectionBlocks; idx++)
+    {
+        m_protection[idx] = static_cast<uint8_t>(idx);
+    }
+}
+
+void SimulatedDS28E15::transmitWithCrc(const uint8_t * data, size_t dataLen)
+{
+    transmitBytes(data, dataLen);
+    transmitInvertedCrc16(data, dataLen);
+}
+
+void SimulatedDS28E15::functionCommand(uint8_t command)
+{
+    switch (command)
+    {
+    case ReadMemory:
+    case LoadAndLockSecret:
+    case ComputeAndLockSecret:
+    case ReadWriteScratchpad:
+    case ComputePageMac:
+    case ReadStatus:
+        m_command = command;
+        m_phase = ParameterPhase;
+        receiveBytes();
+        break;
+        
+    default:
+        waitForReset();
+        break;
+    }
+}
+
+void SimulatedDS28E15::receivedByte(uint8_t data)
+{
+    switch (m_phase)
+    {
+    case ParameterPhase:
+        m_parameter = data;
+        parameterReceived();
+        break;
+        
+    case ScratchpadDataPhase:
+        m_scratchpad[m_dataIndex++] = data;
+        if (m_dataIndex == m_scratchpad.size())
+        {
+            m_phase = ResponsePhase;
+            transmitInvertedCrc16(m_scratchpad.data(), m_scratchpad.size());
+        }
+        break;
+        
+    case ReleasePhase:
+        if (data == successCs)
+        {
+            releaseReceived();
+        }
+        else
+        {
+            waitForReset();
+        }
+        break;
+        
+    default:
+        break;
+    }
+}
+
+void SimulatedDS28E15::parameterReceived()
+{
+    const uint8_t header[] = { m_command, m_parameter };
+    const size_t pageNum = (m_parameter & 0x0F);
+    
+    if (((m_command == ReadMemory) || (m_command == ComputePageMac) || (m_command == ComputeAndLockSecret)) &&
+        (pageNum >= memoryPages))
+    {
+        waitForReset();
+        return;
+    }
+    
+    m_phase = ResponsePhase;
+    transmitInvertedCrc16(header, sizeof(header));
+    
+    switch (m_command)
+    {
+    case ReadWriteScratchpad:
+        if ((m_parameter & 0x0F) == 0x0F)
+        {
+            transmitWithCrc(m_scratchpad.data(), m_scratchpad.size());
+        }
+        break;
+        
+    case ReadMemory:
+        m_readPage = pageNum;
+        transmitWithCrc(m_pages[m_readPage].data(), m_pages[m_readPage].size());
+        break;
+        
+    case ReadStatus:
+        if (m_parameter == lockFlag)
+        {
+            transmitWithCrc(m_personality, sizeof(m_personality));
+        }
+        else if (m_parameter == 0x00)
+        {
+            transmitWithCrc(m_protection, sizeof(m_protection));
+        }
+        else
+        {
+            transmitWithCrc(&m_protection[pageNum % protectionBlocks], 1);
+        }
+        break;
+        
+    default:
+        break;
+    }
+}
+
+void SimulatedDS28E15::transmitComplete()
+{
+    if (m_phase != ResponsePhase)
+    {
+        return;
+    }
+    
+    switch (m_command)
+    {
+    case ReadWriteScratchpad:
+        if ((m_parameter & 0x0F) != 0x0F)
+        {
+            m_phase = ScratchpadDataPhase;
+            m_dataIndex = 0;
+            receiveBytes();
+        }
+        else
+        {
+            waitForReset();
+        }
+        break;
+        
+    case ReadMemory:
+        // Continue with the next page
+        if (++m_readPage < memoryPages)
+        {
+            transmitWithCrc(m_pages[m_readPage].data(), m_pages[m_readPage].size());
+        }
+        else
+        {
+            waitForReset();
+        }
+        break;
+        
+    case ComputePageMac:
+        {
+            ISha256MacCoproc::AuthMacData authMacData;
+            const bool anonymous = ((m_parameter & lockFlag) == lockFlag);
+            for (size_t idx = 0; idx < romId().buffer.size(); idx++)
+            {
+                authMacData[idx] = (anonymous ? 0xFF : romId().buffer[idx]);
+            }
+            authMacData[8] = m_personality[3];
+            authMacData[9] = m_personality[2];
+            authMacData[10] = (m_parameter & 0x0F);
+            authMacData[11] = 0x00;
+            
+            ISha256MacCoproc::Mac mac;
+            SimulatedSha256MacCoproc::computeAuthMac(m_secret, m_pages[m_parameter & 0x0F], m_scratchpad, authMacData, mac);
+            
+            m_phase = ReleasePhase;
+            transmitByte(successCs);
+            transmitWithCrc(mac.data(), mac.size());
+        }
+        break;
+        
+    case LoadAndLockSecret:
+    case ComputeAndLockSecret:
+        m_phase = ReleasePhase;
+        receiveBytes();
+        break;
+        
+    default:
+        waitForReset();
+        break;
+    }
+}
+
+void SimulatedDS28E15::releaseReceived()
+{
+    uint8_t cs = failureCs;
+    
+    if (!secretLocked())
+    {
+        if (m_command == LoadAndLockSecret)
+        {
+            m_secret = m_scratchpad;
+        }
+        else
+        {
+            ISha256MacCoproc::SlaveSecretData slaveSecretData;
+            for (size_t idx = 0; idx < romId().buffer.size(); idx++)
+            {
+                slaveSecretData[idx] = romId().buffer[idx];
+            }
+            slaveSecretData[8] = m_personality[3];
+            slaveSecretData[9] = m_personality[2];
+            slaveSecretData[10] = (m_parameter & 0x0F);
+            slaveSecretData[11] = 0x00;
+            
+            Secret newSecret;
+            SimulatedSha256MacCoproc::computeSecret(m_secret, m_pages[m_parameter & 0x0F], m_scratchpad, slaveSecretData, newSecret);
+            m_secret = newSecret;
+        }
+        
+        if ((m_parameter & lockFlag) == lockFlag)
+        {
+            m_personality[1] |= 0x01;
+        }
+        cs = successCs;
+    }
+    
+    transmitByte(cs);
+}
@@ -0,0 +1,104 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Simulated_SimulatedDS28E15
+#define OneWire_Masters_Simulated_SimulatedDS28E15
+
+#include "Masters/Simulated/SimulatedSlave.h"
+#include "Masters/Simulated/SimulatedSha256MacCoproc.h"
+
+namespace OneWire
+{
+    /// Model of a DS28E15 SHA-256 authenticator. Implements Read/Write
+    /// Scratchpad, Read Memory, Read Status, Compute and Read Page MAC, Load
+    /// and Lock Secret and Compute and Lock Secret using the MAC layout of
+    /// SimulatedSha256MacCoproc. SHA computations complete immediately and
+    /// memory writes and block protection are not modelled.
+    class SimulatedDS28E15 : public SimulatedSlave
+    {
+    public:
+        static const uint8_t familyCode = 0x17;
+        static const size_t memoryPages = 2;
+        static const size_t protectionBlocks = 4;
+        
+        typedef ISha256MacCoproc::DevicePage Page;
+        typedef ISha256MacCoproc::DeviceScratchpad Scratchpad;
+        typedef ISha256MacCoproc::Secret Secret;
+        
+        /// @param romId ROM ID of the device.
+        /// @param manIdLsb, manIdMsb Manufacturer ID reported in the personality.
+        SimulatedDS28E15(const RomId & romId, uint8_t manIdLsb = 0x00, uint8_t manIdMsb = 0x00);
+        
+        /// Direct access to the memory pages.
+        Page & page(size_t pageNum) { return m_pages[pageNum]; }
+        
+        /// @{
+        /// Direct access to the device secret.
+        const Secret & secret() const { return m_secret; }
+        void setSecret(const Secret & secret) { m_secret = secret; }
+        /// @}
+        
+        bool secretLocked() const { return (m_personality[1] & 0x01); }
+        
+    protected:
+        virtual void functionCommand(uint8_t command);
+        virtual void receivedByte(uint8_t data);
+        virtual void transmitComplete();
+        
+    private:
+        enum Phase
+        {
+            ParameterPhase,
+            ResponsePhase,
+            ScratchpadDataPhase,
+            ReleasePhase
+        };
+        
+        array<Page, memoryPages> m_pages;
+        Scratchpad m_scratchpad;
+        Secret m_secret;
+        uint8_t m_personality[4];
+        uint8_t m_protection[protectionBlocks];
+        
+        uint8_t m_command;
+        uint8_t m_parameter;
+        Phase m_phase;
+        size_t m_dataIndex;
+        size_t m_readPage;
+        
+        void transmitWithCrc(const uint8_t * data, size_t dataLen);
+        void parameterReceived();
+        void releaseReceived();
+    };
+}
+
+#endif
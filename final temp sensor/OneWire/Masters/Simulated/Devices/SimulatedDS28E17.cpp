@@ -0,0 +1,294 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Simulated/Devices/SimulatedDS28E17.h"
+#include "Utilities/crc.h"
+#include <cstring>
+
+using namespace OneWire;
+using namespace OneWire::crc;
+
+enum Command
+{
+    WriteDataWithStopCmd = 0x4B,
+    WriteDataNoStopCmd = 0x5A,
+    WriteDataOnlyCmd = 0x69,
+    WriteDataOnlyWithStopCmd = 0x78,
+    ReadDataWithStopCmd = 0x87,
+    WriteReadDataWithStopCmd = 0x2D,
+    WriteConfigurationCmd = 0xD2,
+    ReadConfigurationCmd = 0xE1,
+    EnableSleepModeCmd = 0x1E,
+    ReadDeviceRevisionCmd = 0xC3
+};
+
+enum StatusBits
+{
+    CrcErrorStatus = 0x01,
+    AddressNackStatus = 0x02
+};
+
+static const uint8_t deviceRevision = 0x01;
+static const uint8_t defaultConfig = 0x01;
+
+SimulatedDS28E17::SimulatedDS28E17(const RomId & romId, uint8_t i2cAddress)
+    : SimulatedSlave(romId, true, true), m_i2cAddress(i2cAddress), m_pointer(0), m_pointerSet(false),
+      m_transactionOpen(false), m_config(defaultConfig), m_packetLen(0), m_busyUntilNs(0), m_responseLen(0)
+{
+    std::memset(m_registers, 0x00, sizeof(m_registers));
+}
+
+void SimulatedDS28E17::functionCommand(uint8_t command)
+{
+    m_packet[0] = command;
+    m_packetLen = 1;
+    
+    switch (command)
+    {
+    case WriteDataWithStopCmd:
+    case WriteDataNoStopCmd:
+    case WriteDataOnlyCmd:
+    case WriteDataOnlyWithStopCmd:
+    case ReadDataWithStopCmd:
+    case WriteReadDataWithStopCmd:
+    case WriteConfigurationCmd:
+        receiveBytes();
+        break;
+        
+    case ReadConfigurationCmd:
+        transmitByte(m_config);
+        break;
+        
+    case ReadDeviceRevisionCmd:
+        transmitByte(deviceRevision);
+        break;
+        
+    case EnableSleepModeCmd:
+    default:
+        waitForReset();
+        break;
+    }
+}
+
+size_t SimulatedDS28E17::expectedPacketLength() const
+{
+    // Zero while the length fields have not been received yet
+    size_t length = 0;
+    
+    switch (m_packet[0])
+    {
+    case WriteDataWithStopCmd:
+    case WriteDataNoStopCmd:
+        if (m_packetLen > 2)
+        {
+            length = (3 + m_packet[2] + 2);
+        }
+        break;
+        
+    case WriteDataOnlyCmd:
+    case WriteDataOnlyWithStopCmd:
+        if (m_packetLen > 1)
+        {
+            length = (2 + m_packet[1] + 2);
+        }
+        break;
+        
+    case ReadDataWithStopCmd:
+        length = (3 + 2);
+        break;
+        
+    case WriteReadDataWithStopCmd:
+        if (m_packetLen > 2)
+        {
+            length = (3 + m_packet[2] + 1 + 2);
+        }
+        break;
+        
+    case WriteConfigurationCmd:
+        length = 2;
+        break;
+        
+    default:
+        break;
+    }
+    
+    return length;
+}
+
+void SimulatedDS28E17::receivedByte(uint8_t data)
+{
+    if (m_packetLen < sizeof(m_packet))
+    {
+        m_packet[m_packetLen++] = data;
+    }
+    
+    if (m_packetLen == expectedPacketLength())
+    {
+        if (m_packet[0] == WriteConfigurationCmd)
+        {
+            m_config = m_packet[1];
+            waitForReset();
+        }
+        else
+        {
+            executePacket();
+            transmitStatusBits();
+        }
+    }
+}
+
+bool SimulatedDS28E17::i2cAddress(uint8_t address)
+{
+    m_pointerSet = false;
+    m_transactionOpen = ((address & 0xFE) == (m_i2cAddress & 0xFE));
+    return m_transactionOpen;
+}
+
+void SimulatedDS28E17::i2cWrite(const uint8_t * data, size_t dataLen)
+{
+    for (size_t idx = 0; idx < dataLen; idx++)
+    {
+        if (m_pointerSet)
+        {
+            m_registers[m_pointer++] = data[idx];
+        }
+        else
+        {
+            m_pointer = data[idx];
+            m_pointerSet = true;
+        }
+    }
+}
+
+uint64_t SimulatedDS28E17::i2cTimeNs(size_t numBytes) const
+{
+    static const uint32_t i2cSpeedHz[] = { 100000, 400000, 900000, 900000 };
+    // Nine clocks per byte plus start and stop
+    return (((static_cast<uint64_t>(numBytes) * 9) + 2) * 1000000000ULL / i2cSpeedHz[m_config & 0x03]);
+}
+
+void SimulatedDS28E17::executePacket()
+{
+    const uint8_t command = m_packet[0];
+    const bool writeCommand = (command != ReadDataWithStopCmd);
+    uint8_t status = 0;
+    uint8_t writeStatus = 0;
+    size_t readLen = 0;
+    size_t i2cBytes = 0;
+    
+    if (calculateCrc16(m_packet, m_packetLen) != 0xB001)
+    {
+        status |= CrcErrorStatus;
+    }
+    else
+    {
+        const uint8_t * writeData = NULL;
+        size_t writeLen = 0;
+        bool addressAcked = true;
+        
+        switch (command)
+        {
+        case WriteDataWithStopCmd:
+        case WriteDataNoStopCmd:
+        case WriteReadDataWithStopCmd:
+            addressAcked = i2cAddress(m_packet[1]);
+            writeLen = m_packet[2];
+            writeData = &m_packet[3];
+            i2cBytes = (1 + writeLen);
+            if (command == WriteReadDataWithStopCmd)
+            {
+                readLen = m_packet[3 + writeLen];
+                i2cBytes += (1 + readLen);
+            }
+            break;
+            
+        case WriteDataOnlyCmd:
+        case WriteDataOnlyWithStopCmd:
+            addressAcked = m_transactionOpen;
+            writeLen = m_packet[1];
+            writeData = &m_packet[2];
+            i2cBytes = writeLen;
+            break;
+            
+        case ReadDataWithStopCmd:
+            addressAcked = i2cAddress(m_packet[1]);
+            readLen = m_packet[2];
+            i2cBytes = (1 + readLen);
+            break;
+            
+        default:
+            break;
+        }
+        
+        if (addressAcked)
+        {
+            i2cWrite(writeData, writeLen);
+        }
+        else
+        {
+            status |= AddressNackStatus;
+            readLen = 0;
+        }
+        
+        if ((command != WriteDataNoStopCmd) && (command != WriteDataOnlyCmd))
+        {
+            m_transactionOpen = false;
+        }
+    }
+    
+    m_busyUntilNs = (nowNs() + i2cTimeNs(i2cBytes));
+    
+    m_responseLen = 0;
+    m_response[m_responseLen++] = status;
+    if (writeCommand)
+    {
+        m_response[m_responseLen++] = writeStatus;
+    }
+    for (size_t idx = 0; idx < readLen; idx++)
+    {
+        m_response[m_responseLen++] = m_registers[m_pointer++];
+    }
+}
+
+uint8_t SimulatedDS28E17::statusBit()
+{
+    // Reads 1 while the I2C transaction is running
+    return ((nowNs() < m_busyUntilNs) ? 1 : 0);
+}
+
+void SimulatedDS28E17::statusSlot(uint8_t busBit)
+{
+    if (busBit == 0)
+    {
+        transmitBytes(m_response, m_responseLen);
+    }
+}
@@ -0,0 +1,86 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Simulated_SimulatedDS28E17
+#define OneWire_Masters_Simulated_SimulatedDS28E17
+
+#include "Masters/Simulated/SimulatedSlave.h"
+
+namespace OneWire
+{
+    /// Model of a DS28E17 1-Wire to I2C bridge with a single I2C slave
+    /// attached. The I2C slave is a 256 byte register file where the first
+    /// byte written after the address sets the register pointer.
+    class SimulatedDS28E17 : public SimulatedSlave
+    {
+    public:
+        static const uint8_t familyCode = 0x19;
+        
+        /// @param romId ROM ID of the device.
+        /// @param i2cAddress 8-bit write address of the attached I2C slave.
+        SimulatedDS28E17(const RomId & romId, uint8_t i2cAddress);
+        
+        /// Direct access to the I2C slave registers.
+        uint8_t * i2cRegisters() { return m_registers; }
+        
+        uint8_t config() const { return m_config; }
+        
+    protected:
+        virtual void functionCommand(uint8_t command);
+        virtual void receivedByte(uint8_t data);
+        virtual uint8_t statusBit();
+        virtual void statusSlot(uint8_t busBit);
+        
+    private:
+        uint8_t m_i2cAddress;
+        uint8_t m_registers[256];
+        uint8_t m_pointer;
+        bool m_pointerSet;
+        bool m_transactionOpen;
+        uint8_t m_config;
+        
+        uint8_t m_packet[255 + 5];
+        size_t m_packetLen;
+        
+        uint64_t m_busyUntilNs;
+        uint8_t m_response[2 + 255];
+        size_t m_responseLen;
+        
+        size_t expectedPacketLength() const;
+        void executePacket();
+        bool i2cAddress(uint8_t address);
+        void i2cWrite(const uint8_t * data, size_t dataLen);
+        uint64_t i2cTimeNs(size_t numBytes) const;
+    };
+}
+
+#endif
@@ -0,0 +1,162 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Simulated/Sha256.h"
+
+using namespace OneWire;
+
+static const uint32_t roundConstants[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static uint32_t rotr(uint32_t x, unsigned int n)
+{
+    return ((x >> n) | (x << (32 - n)));
+}
+
+void Sha256::reset()
+{
+    static const uint32_t initialState[8] =
+    {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    
+    for (size_t idx = 0; idx < 8; idx++)
+    {
+        m_state[idx] = initialState[idx];
+    }
+    m_blockLen = 0;
+    m_totalLen = 0;
+}
+
+void Sha256::update(const uint8_t * data, size_t dataLen)
+{
+    for (size_t idx = 0; idx < dataLen; idx++)
+    {
+        m_block[m_blockLen++] = data[idx];
+        if (m_blockLen == sizeof(m_block))
+        {
+            processBlock();
+            m_blockLen = 0;
+        }
+    }
+    m_totalLen += dataLen;
+}
+
+void Sha256::finish(Hash & hash)
+{
+    const uint64_t totalBits = (m_totalLen * 8);
+    
+    m_block[m_blockLen++] = 0x80;
+    if (m_blockLen > 56)
+    {
+        while (m_blockLen < sizeof(m_block))
+        {
+            m_block[m_blockLen++] = 0x00;
+        }
+        processBlock();
+        m_blockLen = 0;
+    }
+    while (m_blockLen < 56)
+    {
+        m_block[m_blockLen++] = 0x00;
+    }
+    for (int idx = 7; idx >= 0; idx--)
+    {
+        m_block[m_blockLen++] = static_cast<uint8_t>(totalBits >> (idx * 8));
+    }
+    processBlock();
+    
+    for (size_t idx = 0; idx < 8; idx++)
+    {
+        hash[(idx * 4) + 0] = static_cast<uint8_t>(m_state[idx] >> 24);
+        hash[(idx * 4) + 1] = static_cast<uint8_t>(m_state[idx] >> 16);
+        hash[(idx * 4) + 2] = static_cast<uint8_t>(m_state[idx] >> 8);
+        hash[(idx * 4) + 3] = static_cast<uint8_t>(m_state[idx]);
+    }
+}
+
+void Sha256::processBlock()
+{
+    uint32_t w[64];
+    
+    for (size_t idx = 0; idx < 16; idx++)
+    {
+        w[idx] = ((static_cast<uint32_t>(m_block[idx * 4]) << 24) | (static_cast<uint32_t>(m_block[(idx * 4) + 1]) << 16) |
+                  (static_cast<uint32_t>(m_block[(idx * 4) + 2]) << 8) | m_block[(idx * 4) + 3]);
+    }
+    for (size_t idx = 16; idx < 64; idx++)
+    {
+        uint32_t s0 = (rotr(w[idx - 15], 7) ^ rotr(w[idx - 15], 18) ^ (w[idx - 15] >> 3));
+        uint32_t s1 = (rotr(w[idx - 2], 17) ^ rotr(w[idx - 2], 19) ^ (w[idx - 2] >> 10));
+        w[idx] = (w[idx - 16] + s0 + w[idx - 7] + s1);
+    }
+    
+    uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+    uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+    
+    for (size_t idx = 0; idx < 64; idx++)
+    {
+        uint32_t s1 = (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25));
+        uint32_t ch = ((e & f) ^ (~e & g));
+        uint32_t temp1 = (h + s1 + ch + roundConstants[idx] + w[idx]);
+        uint32_t s0 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22));
+        uint32_t maj = ((a & b) ^ (a & c) ^ (b & c));
+        uint32_t temp2 = (s0 + maj);
+        
+        h = g;
+        g = f;
+        f = e;
+        e = (d + temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = (temp1 + temp2);
+    }
+    
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+    m_state[4] += e;
+    m_state[5] += f;
+    m_state[6] += g;
+    m_state[7] += h;
+}
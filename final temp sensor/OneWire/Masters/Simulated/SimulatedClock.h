@@ -0,0 +1,62 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Simulated_SimulatedClock
+#define OneWire_Masters_Simulated_SimulatedClock
+
+#include <stdint.h>
+
+namespace OneWire
+{
+    /// Virtual time base shared by a simulated 1-Wire bus and its slaves.
+    /// Time only advances when the bus is used or advance*() is called.
+    class SimulatedClock
+    {
+    public:
+        SimulatedClock() : m_nowNs(0) { }
+        
+        /// Current virtual time in ns.
+        uint64_t nowNs() const { return m_nowNs; }
+        
+        /// Current virtual time in us, truncated to 32 bits like us_ticker_read().
+        uint32_t nowUs() const { return static_cast<uint32_t>(m_nowNs / 1000); }
+        
+        void advanceNs(uint64_t ns) { m_nowNs += ns; }
+        void advanceUs(uint32_t us) { advanceNs(static_cast<uint64_t>(us) * 1000); }
+        void advanceMs(uint32_t ms) { advanceNs(static_cast<uint64_t>(ms) * 1000000); }
+        
+    private:
+        uint64_t m_nowNs;
+    };
+}
+
+#endif
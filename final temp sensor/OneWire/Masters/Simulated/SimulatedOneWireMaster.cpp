@@ -0,0 +1,192 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Simulated/SimulatedOneWireMaster.h"
+#include "Masters/Simulated/SimulatedSlave.h"
+
+using namespace OneWire;
+
+template class OneWire::BasicOneWireMaster<SimulatedOneWireMaster>;
+
+const uint32_t SimulatedOneWireMaster::standardResetNs;
+const uint32_t SimulatedOneWireMaster::standardSlotNs;
+const uint32_t SimulatedOneWireMaster::overdriveResetNs;
+const uint32_t SimulatedOneWireMaster::overdriveWriteZeroNs;
+const uint32_t SimulatedOneWireMaster::overdriveReadNs;
+
+SimulatedOneWireMaster::SimulatedOneWireMaster(SimulatedClock & clock)
+    : m_clock(clock), m_numSlaves(0), m_speed(StandardSpeed), m_level(NormalLevel)
+{
+    resetCounters();
+}
+
+OneWireMaster::CmdResult SimulatedOneWireMaster::attach(SimulatedSlave & slave)
+{
+    OneWireMaster::CmdResult result = OneWireMaster::OperationFailure;
+    
+    if (m_numSlaves < maxSlaves)
+    {
+        slave.setMaster(this);
+        m_slaves[m_numSlaves++] = &slave;
+        result = OneWireMaster::Success;
+    }
+    
+    return result;
+}
+
+void SimulatedOneWireMaster::detachAll()
+{
+    for (size_t idx = 0; idx < m_numSlaves; idx++)
+    {
+        m_slaves[idx]->setMaster(NULL);
+    }
+    m_numSlaves = 0;
+}
+
+void SimulatedOneWireMaster::resetCounters()
+{
+    m_counters.resets = 0;
+    m_counters.bytes = 0;
+    m_counters.bits = 0;
+    m_counters.slots = 0;
+    m_counters.levelChanges = 0;
+}
+
+OneWireMaster::CmdResult SimulatedOneWireMaster::OWInitMaster()
+{
+    m_speed = StandardSpeed;
+    return setLevel(NormalLevel);
+}
+
+OneWireMaster::CmdResult SimulatedOneWireMaster::reset()
+{
+    setLevel(NormalLevel);
+    
+    m_clock.advanceNs((m_speed == OverdriveSpeed) ? overdriveResetNs : standardResetNs);
+    m_counters.resets++;
+    
+    bool presence = false;
+    for (size_t idx = 0; idx < m_numSlaves; idx++)
+    {
+        if (m_slaves[idx]->busReset(m_speed))
+        {
+            presence = true;
+        }
+    }
+    
+    return (presence ? OneWireMaster::Success : OneWireMaster::OperationFailure);
+}
+
+uint8_t SimulatedOneWireMaster::timeSlot(uint8_t sendBit)
+{
+    uint8_t busBit = (sendBit & 0x01);
+    
+    for (size_t idx = 0; idx < m_numSlaves; idx++)
+    {
+        busBit &= m_slaves[idx]->busOutputBit(m_speed);
+    }
+    
+    for (size_t idx = 0; idx < m_numSlaves; idx++)
+    {
+        m_slaves[idx]->busInputBit(m_speed, busBit);
+    }
+    
+    if (m_speed == OverdriveSpeed)
+    {
+        // A write one slot is charged as a read slot, they are identical on the bus
+        m_clock.advanceNs((sendBit & 0x01) ? overdriveReadNs : overdriveWriteZeroNs);
+    }
+    else
+    {
+        m_clock.advanceNs(standardSlotNs);
+    }
+    m_counters.slots++;
+    
+    return busBit;
+}
+
+OneWireMaster::CmdResult SimulatedOneWireMaster::touchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel)
+{
+    setLevel(NormalLevel);
+    sendRecvBit = timeSlot(sendRecvBit);
+    m_counters.bits++;
+    return setLevel(afterLevel);
+}
+
+OneWireMaster::CmdResult SimulatedOneWireMaster::writeByteSetLevel(uint8_t sendByte, OWLevel afterLevel)
+{
+    setLevel(NormalLevel);
+    
+    for (unsigned int idx = 0; idx < 8; idx++)
+    {
+        timeSlot(sendByte >> idx);
+    }
+    m_counters.bytes++;
+    
+    return setLevel(afterLevel);
+}
+
+OneWireMaster::CmdResult SimulatedOneWireMaster::readByteSetLevel(uint8_t & recvByte, OWLevel afterLevel)
+{
+    setLevel(NormalLevel);
+    
+    recvByte = 0;
+    for (unsigned int idx = 0; idx < 8; idx++)
+    {
+        recvByte |= (timeSlot(0x01) << idx);
+    }
+    m_counters.bytes++;
+    
+    return setLevel(afterLevel);
+}
+
+OneWireMaster::CmdResult SimulatedOneWireMaster::setSpeed(OWSpeed newSpeed)
+{
+    m_speed = newSpeed;
+    return OneWireMaster::Success;
+}
+
+OneWireMaster::CmdResult SimulatedOneWireMaster::setLevel(OWLevel newLevel)
+{
+    if (newLevel != m_level)
+    {
+        m_level = newLevel;
+        m_counters.levelChanges++;
+        
+        for (size_t idx = 0; idx < m_numSlaves; idx++)
+        {
+            m_slaves[idx]->busLevel(m_level);
+        }
+    }
+    
+    return OneWireMaster::Success;
+}
@@ -0,0 +1,115 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Simulated_SimulatedOneWireMaster
+#define OneWire_Masters_Simulated_SimulatedOneWireMaster
+
+#include "Masters/BasicOneWireMaster.h"
+#include "Masters/Simulated/SimulatedClock.h"
+#include "Utilities/array.h"
+
+namespace OneWire
+{
+    class SimulatedSlave;
+    
+    /// 1-Wire master that drives an in-memory bus of SimulatedSlave models.
+    /// Every reset and time slot charges the AN126 recommended timing for the
+    /// current speed to the virtual clock so that driver throughput can be
+    /// measured off-target.
+    class SimulatedOneWireMaster : public BasicOneWireMaster<SimulatedOneWireMaster>
+    {
+    public:
+        /// Largest number of slaves on one simulated bus.
+        static const size_t maxSlaves = 64;
+        
+        /// @{
+        /// Time slot durations in ns (AN126 recommended values).
+        static const uint32_t standardResetNs = 960000;
+        static const uint32_t standardSlotNs = 70000;
+        static const uint32_t overdriveResetNs = 121000;
+        static const uint32_t overdriveWriteZeroNs = 10000;
+        static const uint32_t overdriveReadNs = 9000;
+        /// @}
+        
+        /// Bus activity counters. Bytes and bits count master operations,
+        /// slots counts every time slot on the bus including those of bytes.
+        struct Counters
+        {
+            uint32_t resets;
+            uint32_t bytes;
+            uint32_t bits;
+            uint32_t slots;
+            uint32_t levelChanges;
+        };
+        
+        /// @param clock Virtual time base for the bus.
+        explicit SimulatedOneWireMaster(SimulatedClock & clock);
+        
+        /// Attach a slave to the bus.
+        /// @returns OperationFailure if maxSlaves are already attached.
+        CmdResult attach(SimulatedSlave & slave);
+        
+        /// Remove all slaves from the bus.
+        void detachAll();
+        
+        SimulatedClock & clock() const { return m_clock; }
+        OWSpeed speed() const { return m_speed; }
+        OWLevel level() const { return m_level; }
+        const Counters & counters() const { return m_counters; }
+        void resetCounters();
+        
+        virtual CmdResult OWInitMaster();
+        
+        /// @{
+        /// Static interface for BasicOneWireMaster.
+        CmdResult reset();
+        CmdResult touchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel);
+        CmdResult writeByteSetLevel(uint8_t sendByte, OWLevel afterLevel);
+        CmdResult readByteSetLevel(uint8_t & recvByte, OWLevel afterLevel);
+        CmdResult setSpeed(OWSpeed newSpeed);
+        CmdResult setLevel(OWLevel newLevel);
+        /// @}
+        
+    private:
+        SimulatedClock & m_clock;
+        array<SimulatedSlave *, maxSlaves> m_slaves;
+        size_t m_numSlaves;
+        OWSpeed m_speed;
+        OWLevel m_level;
+        Counters m_counters;
+        
+        /// Perform one time slot and return the sampled bus level.
+        uint8_t timeSlot(uint8_t sendBit);
+    };
+}
+
+#endif
@@ -0,0 +1,89 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Simulated/SimulatedSha256MacCoproc.h"
+#include "Masters/Simulated/Sha256.h"
+
+using namespace OneWire;
+
+SimulatedSha256MacCoproc::SimulatedSha256MacCoproc()
+{
+    m_masterSecret.fill(0x00);
+    m_slaveSecret.fill(0x00);
+}
+
+ISha256MacCoproc::CmdResult SimulatedSha256MacCoproc::setMasterSecret(const Secret & masterSecret)
+{
+    m_masterSecret = masterSecret;
+    return Success;
+}
+
+ISha256MacCoproc::CmdResult SimulatedSha256MacCoproc::computeSlaveSecret(const DevicePage & devicePage, const DeviceScratchpad & deviceScratchpad, const SlaveSecretData & slaveSecretData)
+{
+    computeSecret(m_masterSecret, devicePage, deviceScratchpad, slaveSecretData, m_slaveSecret);
+    return Success;
+}
+
+ISha256MacCoproc::CmdResult SimulatedSha256MacCoproc::computeWriteMac(const WriteMacData & writeMacData, Mac & mac) const
+{
+    Sha256 sha;
+    sha.update(m_slaveSecret.data(), m_slaveSecret.size());
+    sha.update(writeMacData.data(), writeMacData.size());
+    sha.finish(mac);
+    return Success;
+}
+
+ISha256MacCoproc::CmdResult SimulatedSha256MacCoproc::computeAuthMac(const DevicePage & devicePage, const DeviceScratchpad & challenge, const AuthMacData & authMacData, Mac & mac) const
+{
+    computeAuthMac(m_slaveSecret, devicePage, challenge, authMacData, mac);
+    return Success;
+}
+
+void SimulatedSha256MacCoproc::computeSecret(const Secret & secret, const DevicePage & devicePage, const DeviceScratchpad & deviceScratchpad, const SlaveSecretData & slaveSecretData, Secret & newSecret)
+{
+    Sha256 sha;
+    sha.update(secret.data(), secret.size());
+    sha.update(devicePage.data(), devicePage.size());
+    sha.update(deviceScratchpad.data(), deviceScratchpad.size());
+    sha.update(slaveSecretData.data(), slaveSecretData.size());
+    sha.finish(newSecret);
+}
+
+void SimulatedSha256MacCoproc::computeAuthMac(const Secret & secret, const DevicePage & devicePage, const DeviceScratchpad & challenge, const AuthMacData & authMacData, Mac & mac)
+{
+    Sha256 sha;
+    sha.update(secret.data(), secret.size());
+    sha.update(devicePage.data(), devicePage.size());
+    sha.update(challenge.data(), challenge.size());
+    sha.update(authMacData.data(), authMacData.size());
+    sha.finish(mac);
+}
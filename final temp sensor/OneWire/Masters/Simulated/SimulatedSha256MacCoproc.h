@@ -0,0 +1,69 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Simulated_SimulatedSha256MacCoproc
+#define OneWire_Masters_Simulated_SimulatedSha256MacCoproc
+
+#include "Slaves/Authenticators/ISha256MacCoproc.h"
+
+namespace OneWire
+{
+    /// Software SHA-256 MAC coprocessor that matches SimulatedDS28E15.
+    /// Every MAC is SHA-256 over the secret followed by the operation's data
+    /// fields in the order they are passed to ISha256MacCoproc. This is the
+    /// simulator's own message layout and is not bit-exact with silicon.
+    class SimulatedSha256MacCoproc : public ISha256MacCoproc
+    {
+    public:
+        SimulatedSha256MacCoproc();
+        
+        virtual CmdResult setMasterSecret(const Secret & masterSecret);
+        virtual CmdResult computeSlaveSecret(const DevicePage & devicePage, const DeviceScratchpad & deviceScratchpad, const SlaveSecretData & slaveSecretData);
+        virtual CmdResult computeWriteMac(const WriteMacData & writeMacData, Mac & mac) const;
+        virtual CmdResult computeAuthMac(const DevicePage & devicePage, const DeviceScratchpad & challenge, const AuthMacData & authMacData, Mac & mac) const;
+        
+        /// Slave secret computed by the last computeSlaveSecret().
+        const Secret & slaveSecret() const { return m_slaveSecret; }
+        
+        /// @{
+        /// Shared MAC computations, also used by SimulatedDS28E15.
+        static void computeSecret(const Secret & secret, const DevicePage & devicePage, const DeviceScratchpad & deviceScratchpad, const SlaveSecretData & slaveSecretData, Secret & newSecret);
+        static void computeAuthMac(const Secret & secret, const DevicePage & devicePage, const DeviceScratchpad & challenge, const AuthMacData & authMacData, Mac & mac);
+        /// @}
+        
+    private:
+        Secret m_masterSecret;
+        Secret m_slaveSecret;
+    };
+}
+
+#endif
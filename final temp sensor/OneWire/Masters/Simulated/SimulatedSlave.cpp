@@ -0,0 +1,387 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Simulated/SimulatedSlave.h"
+#include "Masters/Simulated/SimulatedOneWireMaster.h"
+#include "Utilities/crc.h"
+
+using namespace OneWire;
+using namespace OneWire::crc;
+
+enum RomCmds
+{
+    ReadRomCmd = 0x33,
+    MatchRomCmd = 0x55,
+    SearchRomCmd = 0xF0,
+    SkipRomCmd = 0xCC,
+    ResumeCmd = 0xA5,
+    OverdriveSkipRomCmd = 0x3C,
+    OverdriveMatchRomCmd = 0x69,
+    AlarmSearchCmd = 0xEC
+};
+
+static const unsigned int romBits = 64;
+
+SimulatedSlave::SimulatedSlave(const RomId & romId, bool overdriveCapable, bool resumeCapable)
+    : m_romId(romId), m_master(NULL), m_overdriveCapable(overdriveCapable), m_resumeCapable(resumeCapable),
+      m_overdrive(false), m_resumeFlag(false), m_functionStarted(false), m_state(IdleState), m_mode(ReceiveMode),
+      m_bitIndex(0), m_searchPhase(0), m_rxByte(0), m_txLen(0), m_txIndex(0)
+{
+}
+
+uint64_t SimulatedSlave::nowNs() const
+{
+    return master().clock().nowNs();
+}
+
+bool SimulatedSlave::busReset(OneWireMaster::OWSpeed speed)
+{
+    bool presence = true;
+    
+    if (speed == OneWireMaster::StandardSpeed)
+    {
+        // A standard speed reset returns every slave to standard speed
+        m_overdrive = false;
+    }
+    else if (!m_overdrive)
+    {
+        // Overdrive reset is too short to be seen at standard speed
+        presence = false;
+    }
+    
+    if (presence)
+    {
+        if (m_state == FunctionState)
+        {
+            functionReset();
+        }
+        m_state = RomCommandState;
+        m_bitIndex = 0;
+        m_rxByte = 0;
+    }
+    
+    return presence;
+}
+
+uint8_t SimulatedSlave::romBit(unsigned int bitIndex) const
+{
+    return ((m_romId.buffer[bitIndex / 8] >> (bitIndex % 8)) & 0x01);
+}
+
+uint8_t SimulatedSlave::busOutputBit(OneWireMaster::OWSpeed speed)
+{
+    uint8_t outBit = 1;
+    
+    if (m_overdrive != (speed == OneWireMaster::OverdriveSpeed))
+    {
+        return outBit;
+    }
+    
+    switch (m_state)
+    {
+    case ReadRomState:
+        outBit = romBit(m_bitIndex);
+        break;
+        
+    case SearchRomState:
+        if (m_searchPhase == 0)
+        {
+            outBit = romBit(m_bitIndex);
+        }
+        else if (m_searchPhase == 1)
+        {
+            outBit = (romBit(m_bitIndex) ^ 0x01);
+        }
+        break;
+        
+    case FunctionState:
+        outBit = functionOutputBit();
+        break;
+        
+    default:
+        break;
+    }
+    
+    return outBit;
+}
+
+void SimulatedSlave::busInputBit(OneWireMaster::OWSpeed speed, uint8_t busBit)
+{
+    if (m_overdrive != (speed == OneWireMaster::OverdriveSpeed))
+    {
+        return;
+    }
+    
+    switch (m_state)
+    {
+    case RomCommandState:
+        m_rxByte |= (busBit << m_bitIndex);
+        if (++m_bitIndex == 8)
+        {
+            uint8_t command = m_rxByte;
+            m_bitIndex = 0;
+            m_rxByte = 0;
+            romCommand(command);
+        }
+        break;
+        
+    case ReadRomState:
+        if (++m_bitIndex == romBits)
+        {
+            selected();
+        }
+        break;
+        
+    case MatchRomState:
+        if (busBit != romBit(m_bitIndex))
+        {
+            m_resumeFlag = false;
+            m_state = IdleState;
+        }
+        else if (++m_bitIndex == romBits)
+        {
+            m_resumeFlag = m_resumeCapable;
+            selected();
+        }
+        break;
+        
+    case SearchRomState:
+        if (++m_searchPhase == 3)
+        {
+            m_searchPhase = 0;
+            if (busBit != romBit(m_bitIndex))
+            {
+                m_resumeFlag = false;
+                m_state = IdleState;
+            }
+            else if (++m_bitIndex == romBits)
+            {
+                m_resumeFlag = m_resumeCapable;
+                selected();
+            }
+        }
+        break;
+        
+    case FunctionState:
+        functionInputBit(busBit);
+        break;
+        
+    default:
+        break;
+    }
+}
+
+void SimulatedSlave::romCommand(uint8_t command)
+{
+    bool keepResumeFlag = false;
+    
+    switch (command)
+    {
+    case ReadRomCmd:
+        m_state = ReadRomState;
+        break;
+        
+    case MatchRomCmd:
+        m_state = MatchRomState;
+        break;
+        
+    case SearchRomCmd:
+        m_state = SearchRomState;
+        m_searchPhase = 0;
+        break;
+        
+    case AlarmSearchCmd:
+        m_state = alarmed() ? SearchRomState : IdleState;
+        m_searchPhase = 0;
+        break;
+        
+    case SkipRomCmd:
+        selected();
+        break;
+        
+    case ResumeCmd:
+        keepResumeFlag = m_resumeFlag;
+        if (m_resumeFlag)
+        {
+            selected();
+        }
+        else
+        {
+            m_state = IdleState;
+        }
+        break;
+        
+    case OverdriveSkipRomCmd:
+        if (m_overdriveCapable)
+        {
+            m_overdrive = true;
+            selected();
+        }
+        else
+        {
+            m_state = IdleState;
+        }
+        break;
+        
+    case OverdriveMatchRomCmd:
+        if (m_overdriveCapable)
+        {
+            m_overdrive = true;
+            m_state = MatchRomState;
+        }
+        else
+        {
+            m_state = IdleState;
+        }
+        break;
+        
+    default:
+        m_state = IdleState;
+        break;
+    }
+    
+    // Match and Search set the flag again on success
+    if (!keepResumeFlag)
+    {
+        m_resumeFlag = false;
+    }
+}
+
+void SimulatedSlave::selected()
+{
+    m_state = FunctionState;
+    m_functionStarted = false;
+    m_mode = ReceiveMode;
+    m_bitIndex = 0;
+    m_rxByte = 0;
+    m_txLen = 0;
+    m_txIndex = 0;
+}
+
+void SimulatedSlave::receiveBytes()
+{
+    m_mode = ReceiveMode;
+    m_bitIndex = 0;
+    m_rxByte = 0;
+}
+
+void SimulatedSlave::transmitBytes(const uint8_t * data, size_t dataLen)
+{
+    if (m_mode != TransmitMode)
+    {
+        m_mode = TransmitMode;
+        m_bitIndex = 0;
+        m_txLen = 0;
+        m_txIndex = 0;
+    }
+    
+    for (size_t idx = 0; (idx < dataLen) && (m_txLen < maxTransmitBytes); idx++)
+    {
+        m_txBuffer[m_txLen++] = data[idx];
+    }
+}
+
+void SimulatedSlave::transmitInvertedCrc16(const uint8_t * data, size_t dataLen, uint16_t crc)
+{
+    crc = ~calculateCrc16(data, dataLen, crc);
+    uint8_t crcBytes[] = { static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8) };
+    transmitBytes(crcBytes, 2);
+}
+
+void SimulatedSlave::transmitStatusBits()
+{
+    m_mode = StatusMode;
+}
+
+void SimulatedSlave::waitForReset()
+{
+    m_state = IdleState;
+}
+
+uint8_t SimulatedSlave::functionOutputBit()
+{
+    uint8_t outBit = 1;
+    
+    if (m_mode == TransmitMode)
+    {
+        if (m_txIndex < m_txLen)
+        {
+            outBit = ((m_txBuffer[m_txIndex] >> m_bitIndex) & 0x01);
+        }
+    }
+    else if (m_mode == StatusMode)
+    {
+        outBit = statusBit();
+    }
+    
+    return outBit;
+}
+
+void SimulatedSlave::functionInputBit(uint8_t busBit)
+{
+    if (m_mode == ReceiveMode)
+    {
+        m_rxByte |= (busBit << m_bitIndex);
+        if (++m_bitIndex == 8)
+        {
+            uint8_t data = m_rxByte;
+            m_bitIndex = 0;
+            m_rxByte = 0;
+            if (m_functionStarted)
+            {
+                receivedByte(data);
+            }
+            else
+            {
+                m_functionStarted = true;
+                functionCommand(data);
+            }
+        }
+    }
+    else if (m_mode == TransmitMode)
+    {
+        if ((m_txIndex < m_txLen) && (++m_bitIndex == 8))
+        {
+            m_bitIndex = 0;
+            if (++m_txIndex == m_txLen)
+            {
+                m_txLen = 0;
+                m_txIndex = 0;
+                transmitComplete();
+            }
+        }
+    }
+    else
+    {
+        statusSlot(busBit);
+    }
+}
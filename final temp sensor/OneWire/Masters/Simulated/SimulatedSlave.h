@@ -0,0 +1,170 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Simulated_SimulatedSlave
+#define OneWire_Masters_Simulated_SimulatedSlave
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Masters/OneWireMaster.h"
+#include "RomId/RomId.h"
+#include "Utilities/array.h"
+
+namespace OneWire
+{
+    class SimulatedOneWireMaster;
+    
+    /// Bit-level model of a 1-Wire slave for use with SimulatedOneWireMaster.
+    /// Implements the ROM function layer (Read, Match, Skip, Search, Alarm Search,
+    /// Resume, Overdrive Skip and Overdrive Match ROM). Device models derive from
+    /// this class and implement the memory/control function layer on top of the
+    /// byte-oriented receive/transmit helpers.
+    class SimulatedSlave
+    {
+    public:
+        virtual ~SimulatedSlave() { }
+        
+        const RomId & romId() const { return m_romId; }
+        
+        /// True if the slave is currently communicating at overdrive speed.
+        bool overdrive() const { return m_overdrive; }
+        
+        /// @{
+        /// Bus events, driven by SimulatedOneWireMaster.
+        /// Reset pulse at the given speed.
+        /// @returns True if the slave answers with a presence pulse.
+        bool busReset(OneWireMaster::OWSpeed speed);
+        /// Level driven by the slave during the current time slot, 0 pulls the bus low.
+        uint8_t busOutputBit(OneWireMaster::OWSpeed speed);
+        /// Level sampled on the bus at the end of the current time slot.
+        void busInputBit(OneWireMaster::OWSpeed speed, uint8_t busBit);
+        /// Level set by the master after a time slot.
+        virtual void busLevel(OneWireMaster::OWLevel /*level*/) { }
+        /// @}
+        
+        /// Attach to a master, done by SimulatedOneWireMaster::attach().
+        void setMaster(const SimulatedOneWireMaster * master) { m_master = master; }
+        
+    protected:
+        /// Largest number of bytes that can be queued for transmit.
+        static const size_t maxTransmitBytes = 256;
+        
+        /// @param romId ROM ID of the slave.
+        /// @param overdriveCapable True if the slave supports overdrive speed.
+        /// @param resumeCapable True if the slave supports the Resume ROM command.
+        SimulatedSlave(const RomId & romId, bool overdriveCapable, bool resumeCapable);
+        
+        /// Master this slave is attached to.
+        const SimulatedOneWireMaster & master() const { return *m_master; }
+        
+        /// Current virtual time in ns.
+        uint64_t nowNs() const;
+        
+        /// @{
+        /// Function layer hooks.
+        /// First byte received after the slave has been selected.
+        virtual void functionCommand(uint8_t command) = 0;
+        /// Following bytes received while in receive mode.
+        virtual void receivedByte(uint8_t /*data*/) { }
+        /// All queued bytes have been transmitted.
+        virtual void transmitComplete() { }
+        /// Level to drive in a status read slot, see transmitStatusBits().
+        virtual uint8_t statusBit() { return 1; }
+        /// A status read slot has completed with the given bus level.
+        virtual void statusSlot(uint8_t /*busBit*/) { }
+        /// A reset pulse ended the current function command.
+        virtual void functionReset() { }
+        /// True if the slave should take part in an Alarm Search.
+        virtual bool alarmed() const { return false; }
+        /// @}
+        
+        /// @{
+        /// Function layer mode selection.
+        /// Receive bytes through receivedByte().
+        void receiveBytes();
+        /// Queue bytes to transmit. Transmits 1s once the queue is empty.
+        void transmitBytes(const uint8_t * data, size_t dataLen);
+        void transmitByte(uint8_t data) { transmitBytes(&data, 1); }
+        /// Answer every read slot with statusBit().
+        void transmitStatusBits();
+        /// Ignore the bus until the next reset.
+        void waitForReset();
+        /// @}
+        
+        /// Append the inverted CRC16 of data to the transmit queue.
+        void transmitInvertedCrc16(const uint8_t * data, size_t dataLen, uint16_t crc = 0);
+        
+    private:
+        enum State
+        {
+            IdleState,
+            RomCommandState,
+            ReadRomState,
+            MatchRomState,
+            SearchRomState,
+            FunctionState
+        };
+        
+        enum FunctionMode
+        {
+            ReceiveMode,
+            TransmitMode,
+            StatusMode
+        };
+        
+        RomId m_romId;
+        const SimulatedOneWireMaster * m_master;
+        bool m_overdriveCapable;
+        bool m_resumeCapable;
+        bool m_overdrive;
+        bool m_resumeFlag;
+        bool m_functionStarted;
+        
+        State m_state;
+        FunctionMode m_mode;
+        unsigned int m_bitIndex;
+        unsigned int m_searchPhase;
+        uint8_t m_rxByte;
+        
+        array<uint8_t, maxTransmitBytes> m_txBuffer;
+        size_t m_txLen;
+        size_t m_txIndex;
+        
+        uint8_t romBit(unsigned int bitIndex) const;
+        void romCommand(uint8_t command);
+        void selected();
+        void functionInputBit(uint8_t busBit);
+        uint8_t functionOutputBit();
+    };
+}
+
+#endif
@@ -41,6 +41,8 @@
 using OneWire::OneWireMaster;
 using OneWire::OwGpio;
 
+template class OneWire::BasicOneWireMaster<OwGpio>;
+
 static const OwTiming stdTiming = {
                                       560, // tRSTL
                                       68, // tMSP
@@ -80,12 +82,12 @@ OneWireMaster::CmdResult OwGpio::OWInitMaster()
     MXC_GPIO->in_mode[owPort] &= ~(0xF << (4 * owPin));
 
     writeOwGpioHigh();
-    OWSetLevel(NormalLevel);
+    setLevel(NormalLevel);
 
     return OneWireMaster::Success;
 }
 
-OneWireMaster::CmdResult OwGpio::OWReset()
+OneWireMaster::CmdResult OwGpio::reset()
 {
     const OwTiming & curTiming(owSpeed == OverdriveSpeed ? odTiming : stdTiming);
     uint16_t tREC = curTiming.tRSTL - curTiming.tMSP; // tSLOT = 2 *tRSTL
@@ -104,72 +106,26 @@ OneWireMaster::CmdResult OwGpio::OWReset()
     return((pd_pulse == 0) ? OneWireMaster::Success : OneWireMaster::OperationFailure);
 }
 
-OneWireMaster::CmdResult OwGpio::OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel)
+OneWireMaster::CmdResult OwGpio::touchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel)
 {
     __disable_irq(); // Enter critical section
 
     ow_bit(&sendRecvBit, &MXC_GPIO->in_val[owPort], &MXC_GPIO->out_val[owPort], (1 << owPin),
             ((owSpeed == OverdriveSpeed) ? &odTiming : &stdTiming));
-    OWSetLevel(afterLevel);
+    setLevel(afterLevel);
 
     __enable_irq(); // Exit critical section
 
     return OneWireMaster::Success;
 }
 
-OneWireMaster::CmdResult OwGpio::OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel)
-{
-    OneWireMaster::CmdResult result;
-
-    for (uint8_t idx = 0; idx < 8; idx++)
-    {
-        result = OneWireMaster::OWWriteBit(0x01 & (sendByte >> idx));
-        if (result != OneWireMaster::Success)
-        {
-            break;
-        }
-    }
-
-    if (result == OneWireMaster::Success)
-    {
-        OWSetLevel(afterLevel);
-    }
-
-    return result;
-}
-
-OneWireMaster::CmdResult OwGpio::OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel)
-{
-    OneWireMaster::CmdResult result;
-    uint8_t recvBit;
-    recvByte = 0;
-
-    for (unsigned int idx = 0; idx < 8; idx++)
-    {
-        result = OneWireMaster::OWReadBit(recvBit);
-        if (result != OneWireMaster::Success)
-        {
-            break;
-        }
-        //else
-        recvByte |= ((0x01 & recvBit) << idx);
-    }
-
-    if (result == OneWireMaster::Success)
-    {
-        OWSetLevel(afterLevel);
-    }
-
-    return result;
-}
-
-OneWireMaster::CmdResult OwGpio::OWSetSpeed(OWSpeed newSpeed)
+OneWireMaster::CmdResult OwGpio::setSpeed(OWSpeed newSpeed)
 {
     owSpeed = newSpeed;
     return OneWireMaster::Success;
 }
 
-OneWireMaster::CmdResult OwGpio::OWSetLevel(OWLevel newLevel)
+OneWireMaster::CmdResult OwGpio::setLevel(OWLevel newLevel)
 {    
     switch (newLevel)
     {
@@ -35,13 +35,13 @@
 
 #ifdef TARGET_MAX32600
 
-#include "Masters/OneWireMaster.h"
+#include "Masters/BasicOneWireMaster.h"
 #include "DigitalOut.h"
 
 namespace OneWire
 {
     ///One Wire Bit-Bang master
-    class OwGpio : public OneWireMaster
+    class OwGpio : public BasicOneWireMaster<OwGpio>
     {
     public:
         /// @param owGpio Pin to use for 1-Wire bus
@@ -49,12 +49,15 @@ namespace OneWire
         OwGpio(PinName owGpio, PinName extSpu = NC, bool extSpuActiveHigh = false);
 
         virtual OneWireMaster::CmdResult OWInitMaster();
-        virtual OneWireMaster::CmdResult OWReset();
-        virtual OneWireMaster::CmdResult OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel);
-        virtual OneWireMaster::CmdResult OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel);
-        virtual OneWireMaster::CmdResult OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel);
-        virtual OneWireMaster::CmdResult OWSetSpeed(OWSpeed newSpeed);
-        virtual OneWireMaster::CmdResult OWSetLevel(OWLevel newLevel);
+        
+        /// @{
+        /// Static interface for BasicOneWireMaster, bytes and blocks are
+        /// built from touchBitSetLevel() without virtual calls.
+        OneWireMaster::CmdResult reset();
+        OneWireMaster::CmdResult touchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel);
+        OneWireMaster::CmdResult setSpeed(OWSpeed newSpeed);
+        OneWireMaster::CmdResult setLevel(OWLevel newLevel);
+        /// @}
 
     private:
         const unsigned int owPort;
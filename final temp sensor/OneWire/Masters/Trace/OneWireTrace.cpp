@@ -0,0 +1,247 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Trace/OneWireTrace.h"
+
+using namespace OneWire;
+using namespace OneWire::Trace;
+
+static const uint8_t chunkMagic[] = { 'O', 'W', 'T' };
+static const uint8_t opcodeMask = 0x0F;
+static const uint8_t resultShift = 4;
+static const uint8_t resultMask = 0x07;
+static const uint8_t blockStartFlag = 0x80;
+
+enum Payload
+{
+    NoPayload = 0x00,
+    ArgPayload = 0x01,
+    DataPayload = 0x02
+};
+
+static unsigned int payload(uint8_t opcode)
+{
+    unsigned int result = NoPayload;
+    
+    switch (opcode)
+    {
+    case TouchBitOp:
+    case WriteByteOp:
+    case ReadByteOp:
+    case TripletOp:
+        result = (ArgPayload | DataPayload);
+        break;
+        
+    case WriteBlockOp:
+    case ReadBlockOp:
+        result = DataPayload;
+        break;
+        
+    case SetSpeedOp:
+    case SetLevelOp:
+        result = ArgPayload;
+        break;
+        
+    default:
+        break;
+    }
+    
+    return result;
+}
+
+void Writer::writeVarint(uint32_t value)
+{
+    uint8_t buf[5];
+    size_t len = 0;
+    
+    do
+    {
+        buf[len] = (value & 0x7F);
+        value >>= 7;
+        if (value != 0)
+        {
+            buf[len] |= 0x80;
+        }
+        len++;
+    }
+    while (value != 0);
+    
+    m_sink.write(buf, len);
+}
+
+void Writer::beginChunk(uint32_t eventCount, uint32_t droppedEvents, uint32_t firstStartUs)
+{
+    m_sink.write(chunkMagic, sizeof(chunkMagic));
+    m_sink.write(&version, 1);
+    writeVarint(eventCount);
+    writeVarint(droppedEvents);
+    writeVarint(firstStartUs);
+    m_lastStartUs = firstStartUs;
+}
+
+void Writer::writeEvent(const Event & event)
+{
+    uint8_t header = ((event.opcode & opcodeMask) | ((event.result & resultMask) << resultShift));
+    if (event.blockStart)
+    {
+        header |= blockStartFlag;
+    }
+    m_sink.write(&header, 1);
+    
+    writeVarint(event.startUs - m_lastStartUs);
+    writeVarint(event.durationUs);
+    m_lastStartUs = event.startUs;
+    
+    const unsigned int eventPayload = payload(event.opcode);
+    if (eventPayload & ArgPayload)
+    {
+        m_sink.write(&event.arg, 1);
+    }
+    if (eventPayload & DataPayload)
+    {
+        m_sink.write(&event.data, 1);
+    }
+}
+
+Reader::Reader(const uint8_t * stream, size_t streamLen)
+    : m_stream(stream), m_streamLen(streamLen), m_pos(0), m_chunkEvents(0), m_droppedEvents(0), m_lastStartUs(0),
+      m_malformed(false)
+{
+    
+}
+
+bool Reader::readByte(uint8_t & value)
+{
+    bool result = (m_pos < m_streamLen);
+    if (result)
+    {
+        value = m_stream[m_pos++];
+    }
+    return result;
+}
+
+bool Reader::readVarint(uint32_t & value)
+{
+    uint8_t byte;
+    unsigned int shift = 0;
+    
+    value = 0;
+    do
+    {
+        if ((shift > 28) || !readByte(byte))
+        {
+            return false;
+        }
+        value |= (static_cast<uint32_t>(byte & 0x7F) << shift);
+        shift += 7;
+    }
+    while (byte & 0x80);
+    
+    return true;
+}
+
+bool Reader::readChunkHeader()
+{
+    uint8_t byte;
+    
+    for (size_t idx = 0; idx < sizeof(chunkMagic); idx++)
+    {
+        if (!readByte(byte) || (byte != chunkMagic[idx]))
+        {
+            return false;
+        }
+    }
+    
+    uint32_t dropped;
+    if (!readByte(byte) || (byte != version) || !readVarint(m_chunkEvents) || !readVarint(dropped) ||
+        !readVarint(m_lastStartUs))
+    {
+        return false;
+    }
+    m_droppedEvents += dropped;
+    
+    return true;
+}
+
+bool Reader::next(Event & event)
+{
+    if (m_malformed)
+    {
+        return false;
+    }
+    
+    // Skip to the next chunk with events
+    while (m_chunkEvents == 0)
+    {
+        if (m_pos == m_streamLen)
+        {
+            return false;
+        }
+        if (!readChunkHeader())
+        {
+            m_malformed = true;
+            return false;
+        }
+    }
+    
+    uint8_t header;
+    uint32_t delta;
+    if (!readByte(header) || !readVarint(delta) || !readVarint(event.durationUs))
+    {
+        m_malformed = true;
+        return false;
+    }
+    
+    event.opcode = (header & opcodeMask);
+    event.result = ((header >> resultShift) & resultMask);
+    event.blockStart = ((header & blockStartFlag) == blockStartFlag);
+    event.startUs = (m_lastStartUs + delta);
+    event.arg = 0;
+    event.data = 0;
+    m_lastStartUs = event.startUs;
+    
+    if (event.opcode >= NumOpcodes)
+    {
+        m_malformed = true;
+        return false;
+    }
+    
+    const unsigned int eventPayload = payload(event.opcode);
+    if (((eventPayload & ArgPayload) && !readByte(event.arg)) || ((eventPayload & DataPayload) && !readByte(event.data)))
+    {
+        m_malformed = true;
+        return false;
+    }
+    
+    m_chunkEvents--;
+    return true;
+}
@@ -0,0 +1,145 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Trace_OneWireTrace
+#define OneWire_Masters_Trace_OneWireTrace
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace OneWire
+{
+    /// Recorded 1-Wire master operations and their binary stream format.
+    ///
+    /// A stream is a sequence of chunks, each one produced by a single flush:
+    ///
+    ///     'O' 'W' 'T' version
+    ///     varint eventCount
+    ///     varint droppedEvents      (lost to ring buffer overwrite before this chunk)
+    ///     varint firstStartUs
+    ///     events...
+    ///
+    /// Each event is a header byte with the opcode in bits 0-3, the result in
+    /// bits 4-6 and the block start flag in bit 7, then varint start time
+    /// delta from the previous event, varint duration and the opcode payload.
+    /// Varints are unsigned LEB128.
+    namespace Trace
+    {
+        static const uint8_t version = 1;
+        
+        enum Opcode
+        {
+            InitMasterOp,
+            ResetOp,
+            TouchBitOp,     ///< arg: level, data: sent bit in bit 0, received bit in bit 1
+            WriteByteOp,    ///< arg: level, data: byte sent
+            ReadByteOp,     ///< arg: level, data: byte received
+            WriteBlockOp,   ///< data: byte sent, one event per byte
+            ReadBlockOp,    ///< data: byte received, one event per byte
+            SetSpeedOp,     ///< arg: speed
+            SetLevelOp,     ///< arg: level
+            TripletOp,      ///< arg: requested direction, data: sbr, tsb and direction taken in bits 0-2
+            NumOpcodes
+        };
+        
+        /// One recorded operation. Block operations are recorded as one event
+        /// per byte, the first carries the block flag and the duration. An
+        /// empty block is recorded as a single event without the block flag.
+        struct Event
+        {
+            uint32_t startUs;
+            uint32_t durationUs;
+            uint8_t opcode;
+            uint8_t result;
+            uint8_t arg;
+            uint8_t data;
+            bool blockStart;
+        };
+        
+        /// Destination for a flushed trace stream.
+        class Sink
+        {
+        public:
+            virtual ~Sink() { }
+            virtual void write(const uint8_t * data, size_t dataLen) = 0;
+        };
+        
+        /// Writes trace chunks to a Sink.
+        class Writer
+        {
+        public:
+            explicit Writer(Sink & sink) : m_sink(sink), m_lastStartUs(0) { }
+            
+            /// Begin a chunk, must be followed by exactly eventCount calls to writeEvent().
+            void beginChunk(uint32_t eventCount, uint32_t droppedEvents, uint32_t firstStartUs);
+            void writeEvent(const Event & event);
+            
+        private:
+            Sink & m_sink;
+            uint32_t m_lastStartUs;
+            
+            void writeVarint(uint32_t value);
+        };
+        
+        /// Reads events back from a trace stream held in memory.
+        class Reader
+        {
+        public:
+            Reader(const uint8_t * stream, size_t streamLen);
+            
+            /// Read the next event.
+            /// @returns False at the end of the stream or if the stream is malformed.
+            bool next(Event & event);
+            
+            /// True if reading stopped on a malformed stream.
+            bool malformed() const { return m_malformed; }
+            
+            /// Total events dropped by the recorder over the chunks read so far.
+            uint32_t droppedEvents() const { return m_droppedEvents; }
+            
+        private:
+            const uint8_t * m_stream;
+            size_t m_streamLen;
+            size_t m_pos;
+            uint32_t m_chunkEvents;
+            uint32_t m_droppedEvents;
+            uint32_t m_lastStartUs;
+            bool m_malformed;
+            
+            bool readByte(uint8_t & value);
+            bool readVarint(uint32_t & value);
+            bool readChunkHeader();
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,214 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Masters/Trace/ReplayOneWireMaster.h"
+#include "wait_api.h"
+
+using namespace OneWire;
+
+ReplayOneWireMaster::ReplayOneWireMaster(const uint8_t * stream, size_t streamLen)
+    : m_reader(stream, streamLen), m_eventsReplayed(0), m_diverged(false)
+{
+    
+}
+
+bool ReplayOneWireMaster::nextEvent(Trace::Opcode opcode, Trace::Event & event)
+{
+    if (!m_diverged)
+    {
+        m_diverged = (!m_reader.next(event) || (event.opcode != opcode));
+    }
+    
+    if (!m_diverged)
+    {
+        m_eventsReplayed++;
+    }
+    
+    return !m_diverged;
+}
+
+bool ReplayOneWireMaster::expect(bool match)
+{
+    if (!match)
+    {
+        m_diverged = true;
+    }
+    return match;
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::replay(const Trace::Event & event)
+{
+    if (event.durationUs != 0)
+    {
+        wait_us(event.durationUs);
+    }
+    return static_cast<CmdResult>(event.result);
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWInitMaster()
+{
+    Trace::Event event;
+    if (!nextEvent(Trace::InitMasterOp, event))
+    {
+        return OperationFailure;
+    }
+    return replay(event);
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWReset()
+{
+    Trace::Event event;
+    if (!nextEvent(Trace::ResetOp, event))
+    {
+        return OperationFailure;
+    }
+    return replay(event);
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel)
+{
+    Trace::Event event;
+    if (!nextEvent(Trace::TouchBitOp, event) ||
+        !expect((event.arg == afterLevel) && ((event.data & 0x01) == (sendRecvBit & 0x01))))
+    {
+        return OperationFailure;
+    }
+    sendRecvBit = ((event.data >> 1) & 0x01);
+    return replay(event);
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel)
+{
+    Trace::Event event;
+    if (!nextEvent(Trace::WriteByteOp, event) || !expect((event.arg == afterLevel) && (event.data == sendByte)))
+    {
+        return OperationFailure;
+    }
+    return replay(event);
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel)
+{
+    Trace::Event event;
+    if (!nextEvent(Trace::ReadByteOp, event) || !expect(event.arg == afterLevel))
+    {
+        return OperationFailure;
+    }
+    recvByte = event.data;
+    return replay(event);
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWWriteBlock(const uint8_t *sendBuf, size_t sendLen)
+{
+    Trace::Event event;
+    
+    if (sendLen == 0)
+    {
+        if (!nextEvent(Trace::WriteBlockOp, event) || !expect(!event.blockStart))
+        {
+            return OperationFailure;
+        }
+        return replay(event);
+    }
+    
+    CmdResult result = OperationFailure;
+    for (size_t idx = 0; idx < sendLen; idx++)
+    {
+        if (!nextEvent(Trace::WriteBlockOp, event) || !expect((event.blockStart == (idx == 0)) && (event.data == sendBuf[idx])))
+        {
+            return OperationFailure;
+        }
+        result = replay(event);
+    }
+    
+    return result;
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWReadBlock(uint8_t *recvBuf, size_t recvLen)
+{
+    Trace::Event event;
+    
+    if (recvLen == 0)
+    {
+        if (!nextEvent(Trace::ReadBlockOp, event) || !expect(!event.blockStart))
+        {
+            return OperationFailure;
+        }
+        return replay(event);
+    }
+    
+    CmdResult result = OperationFailure;
+    for (size_t idx = 0; idx < recvLen; idx++)
+    {
+        if (!nextEvent(Trace::ReadBlockOp, event) || !expect(event.blockStart == (idx == 0)))
+        {
+            return OperationFailure;
+        }
+        recvBuf[idx] = event.data;
+        result = replay(event);
+    }
+    
+    return result;
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWSetSpeed(OWSpeed newSpeed)
+{
+    Trace::Event event;
+    if (!nextEvent(Trace::SetSpeedOp, event) || !expect(event.arg == newSpeed))
+    {
+        return OperationFailure;
+    }
+    return replay(event);
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWSetLevel(OWLevel newLevel)
+{
+    Trace::Event event;
+    if (!nextEvent(Trace::SetLevelOp, event) || !expect(event.arg == newLevel))
+    {
+        return OperationFailure;
+    }
+    return replay(event);
+}
+
+OneWireMaster::CmdResult ReplayOneWireMaster::OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb)
+{
+    Trace::Event event;
+    if (!nextEvent(Trace::TripletOp, event) || !expect(event.arg == searchDirection))
+    {
+        return OperationFailure;
+    }
+    sbr = (event.data & 0x01);
+    tsb = ((event.data >> 1) & 0x01);
+    searchDirection = (((event.data >> 2) & 0x01) ? WriteOne : WriteZero);
+    return replay(event);
+}
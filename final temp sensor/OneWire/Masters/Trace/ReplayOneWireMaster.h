@@ -0,0 +1,91 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Masters_Trace_ReplayOneWireMaster
+#define OneWire_Masters_Trace_ReplayOneWireMaster
+
+#include "Masters/OneWireMaster.h"
+#include "Masters/Trace/OneWireTrace.h"
+
+namespace OneWire
+{
+    /// 1-Wire master that plays back a trace recorded by TracingOneWireMaster.
+    /// Each operation consumes the next recorded event and returns its
+    /// recorded result and read data after waiting for its recorded duration,
+    /// so the host wait shims reproduce the field bus time. The driver code
+    /// must issue the same sequence of operations as when the trace was
+    /// recorded. If an operation or its written data, level or speed does not
+    /// match, replay stops and every further operation fails.
+    class ReplayOneWireMaster : public OneWireMaster
+    {
+    public:
+        /// @param stream Trace stream, must remain valid while replaying.
+        /// @param streamLen Length of the trace stream in bytes.
+        ReplayOneWireMaster(const uint8_t * stream, size_t streamLen);
+        
+        /// True once an operation did not match the trace.
+        bool diverged() const { return m_diverged; }
+        
+        /// True if the trace stream is malformed.
+        bool malformed() const { return m_reader.malformed(); }
+        
+        /// Number of events played back.
+        uint32_t eventsReplayed() const { return m_eventsReplayed; }
+        
+        virtual CmdResult OWInitMaster();
+        virtual CmdResult OWReset();
+        virtual CmdResult OWTouchBitSetLevel(uint8_t & sendRecvBit, OWLevel afterLevel);
+        virtual CmdResult OWWriteByteSetLevel(uint8_t sendByte, OWLevel afterLevel);
+        virtual CmdResult OWReadByteSetLevel(uint8_t & recvByte, OWLevel afterLevel);
+        virtual CmdResult OWWriteBlock(const uint8_t *sendBuf, size_t sendLen);
+        virtual CmdResult OWReadBlock(uint8_t *recvBuf, size_t recvLen);
+        virtual CmdResult OWSetSpeed(OWSpeed newSpeed);
+        virtual CmdResult OWSetLevel(OWLevel newLevel);
+        virtual CmdResult OWTriplet(SearchDirection & searchDirection, uint8_t & sbr, uint8_t & tsb);
+        
+    private:
+        Trace::Reader m_reader;
+        uint32_t m_eventsReplayed;
+        bool m_diverged;
+        
+        /// Read the next event and check that it is the expected operation.
+        bool nextEvent(Trace::Opcode opcode, Trace::Event & event);
+        
+        /// Check a written value against the trace, diverging on mismatch.
+        bool expect(bool match);
+        
+        /// Wait for the recorded duration and return the recorded result.
+        CmdResult replay(const Trace::Event & event);
+    };
+}
+
+#endif
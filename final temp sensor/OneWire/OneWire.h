@@ -36,6 +36,7 @@
 
 #include "Masters/Masters.h"
 #include "RomId/RomCommands.h"
+#include "Scheduler/Scheduler.h"
 #include "Slaves/Slaves.h"
 
 #endif /* MBED_OneWire */
@@ -0,0 +1,264 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_BasicRomCommands
+#define OneWire_BasicRomCommands
+
+#include <string.h>
+#include "Masters/BasicOneWireMaster.h"
+#include "Utilities/crc.h"
+
+namespace OneWire
+{
+    namespace RomCommands
+    {
+        enum OwRomCmd
+        {
+            ReadRomCmd = 0x33,
+            MatchRomCmd = 0x55,
+            SearchRomCmd = 0xF0,
+            SkipRomCmd = 0xCC,
+            ResumeCmd = 0xA5,
+            OverdriveSkipRomCmd = 0x3C,
+            OverdriveMatchRomCmd = 0x69,
+            AlarmSearchCmd = 0xEC
+        };
+        
+        /// @{
+        /// ROM commands on the static interface of a BasicOneWireMaster or
+        /// OneWireMasterRef. The caller holds the bus lock.
+        template <class Master>
+        OneWireMaster::CmdResult searchAll(Master & master, SearchState & searchState, bool alarmSearch);
+        
+        template <class Master>
+        OneWireMaster::CmdResult matchRom(Master & master, const RomId & romId)
+        {
+            OneWireMaster::CmdResult result;
+            
+            uint8_t buf[1 + RomId::Buffer::csize];
+            
+            // use MatchROM
+            result = master.reset();
+            if (result == OneWireMaster::Success)
+            {
+                buf[0] = MatchRomCmd;
+                memcpy(&buf[1], romId.buffer.data(), romId.buffer.size());
+                // send command and rom
+                result = master.writeBlock(buf, 1 + romId.buffer.size());
+            }
+            
+            return result;
+        }
+        
+        template <class Master>
+        OneWireMaster::CmdResult skipRom(Master & master)
+        {
+            OneWireMaster::CmdResult result = master.reset();
+            if (result == OneWireMaster::Success)
+            {
+                result = master.writeByteSetLevel(SkipRomCmd, OneWireMaster::NormalLevel);
+            }
+            
+            return result;
+        }
+        
+        template <class Master>
+        OneWireMaster::CmdResult resume(Master & master)
+        {
+            OneWireMaster::CmdResult result = master.reset();
+            if (result == OneWireMaster::Success)
+            {
+                result = master.writeByteSetLevel(ResumeCmd, OneWireMaster::NormalLevel);
+            }
+            
+            return result;
+        }
+        /// @}
+        
+        /// @{
+        /// Overloads chosen for concrete masters derived from BasicOneWireMaster,
+        /// they run without virtual calls per bit or byte.
+        template <class Impl>
+        OneWireMaster::CmdResult OWSearchAll(BasicOneWireMaster<Impl> & master, SearchState & searchState, bool alarmSearch)
+        {
+            OneWireMaster::Lock busLock(master);
+            return searchAll(static_cast<Impl &>(master), searchState, alarmSearch);
+        }
+        
+        template <class Impl>
+        OneWireMaster::CmdResult OWSearch(BasicOneWireMaster<Impl> & master, SearchState & searchState)
+        {
+            return OWSearchAll(master, searchState, false);
+        }
+        
+        template <class Impl>
+        OneWireMaster::CmdResult OWFirst(BasicOneWireMaster<Impl> & master, SearchState & searchState)
+        {
+            searchState.reset();
+            return OWSearchAll(master, searchState, false);
+        }
+        
+        template <class Impl>
+        OneWireMaster::CmdResult OWNext(BasicOneWireMaster<Impl> & master, SearchState & searchState)
+        {
+            return OWSearchAll(master, searchState, false);
+        }
+        
+        template <class Impl>
+        OneWireMaster::CmdResult OWMatchRom(BasicOneWireMaster<Impl> & master, const RomId & romId)
+        {
+            OneWireMaster::Lock busLock(master);
+            return matchRom(static_cast<Impl &>(master), romId);
+        }
+        
+        template <class Impl>
+        OneWireMaster::CmdResult OWSkipRom(BasicOneWireMaster<Impl> & master)
+        {
+            OneWireMaster::Lock busLock(master);
+            return skipRom(static_cast<Impl &>(master));
+        }
+        
+        template <class Impl>
+        OneWireMaster::CmdResult OWResume(BasicOneWireMaster<Impl> & master)
+        {
+            OneWireMaster::Lock busLock(master);
+            return resume(static_cast<Impl &>(master));
+        }
+        /// @}
+        
+        template <class Master>
+        OneWireMaster::CmdResult searchAll(Master & master, SearchState & searchState, bool alarmSearch)
+        {
+            uint8_t id_bit_number;
+            uint8_t last_zero, rom_byte_number;
+            uint8_t rom_byte_mask;
+            bool search_result;
+            uint8_t discrepancies[RomId::Buffer::csize];
+
+            // initialize for search
+            last_zero = 0;
+            search_result = false;
+
+            // if the last call was not the last one
+            if (!searchState.last_device_flag)
+            {
+                // 1-Wire reset
+                OneWireMaster::CmdResult result = master.reset();
+                if (result != OneWireMaster::Success)
+                {
+                    // reset the search
+                    searchState.reset();
+                    return result;
+                }
+
+                // issue the search command 
+                if(alarmSearch){
+                    master.writeByteSetLevel(AlarmSearchCmd, OneWireMaster::NormalLevel);
+                }
+                else{
+                    master.writeByteSetLevel(SearchRomCmd, OneWireMaster::NormalLevel);
+                }
+
+                // build the search path, if a discrepancy is before the Last Discrepancy
+                // on a previous next then pick the same as last time, if equal to last
+                // pick 1, if not then pick 0
+                for (id_bit_number = 1; id_bit_number <= (searchState.romId.buffer.size() * 8); id_bit_number++)
+                {
+                    rom_byte_number = ((id_bit_number - 1) / 8);
+                    rom_byte_mask = (1 << ((id_bit_number - 1) % 8));
+                    
+                    if (id_bit_number == searchState.last_discrepancy)
+                    {
+                        searchState.romId.buffer[rom_byte_number] |= rom_byte_mask;
+                    }
+                    else if (id_bit_number > searchState.last_discrepancy)
+                    {
+                        searchState.romId.buffer[rom_byte_number] &= (uint8_t)~rom_byte_mask;
+                    }
+                }
+
+                // Perform all triplets of the search, natively if the master has a search accelerator
+                result = master.searchRom(searchState.romId.buffer.data(), discrepancies);
+                if ((result != OneWireMaster::Success) && (result != OneWireMaster::OperationFailure))
+                {
+                    return result;
+                }
+
+                // if the search was successful then
+                if ((result == OneWireMaster::Success) && 
+                    (crc::calculateCrc8(searchState.romId.buffer.data(), searchState.romId.buffer.size(), 0x00) == 0))
+                {
+                    // find the last discrepancy where the 0 path was taken
+                    for (id_bit_number = 1; id_bit_number <= (searchState.romId.buffer.size() * 8); id_bit_number++)
+                    {
+                        rom_byte_number = ((id_bit_number - 1) / 8);
+                        rom_byte_mask = (1 << ((id_bit_number - 1) % 8));
+                        
+                        if (((discrepancies[rom_byte_number] & rom_byte_mask) != 0) && 
+                            ((searchState.romId.buffer[rom_byte_number] & rom_byte_mask) == 0))
+                        {
+                            last_zero = id_bit_number;
+
+                            // check for Last discrepancy in family
+                            if (last_zero < 9)
+                            {
+                                searchState.last_family_discrepancy = last_zero;
+                            }
+                        }
+                    }
+                    
+                    // search successful so set m_last_discrepancy,m_last_device_flag,search_result
+                    searchState.last_discrepancy = last_zero;
+
+                    // check for last device
+                    if (searchState.last_discrepancy == 0)
+                    {
+                        searchState.last_device_flag = true;
+                    }
+
+                    search_result = true;
+                }
+            }
+
+            // if no device found then reset counters so next 'search' will be like a first
+            if (!search_result || (searchState.romId.familyCode() == 0))
+            {
+                searchState.reset();
+                search_result = false;
+            }
+
+            return (search_result ? OneWireMaster::Success : OneWireMaster::OperationFailure);
+        }
+    }
+}
+
+#endif
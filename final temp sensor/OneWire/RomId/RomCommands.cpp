@@ -32,24 +32,10 @@
 
 #include "RomId/RomCommands.h"
 
-using namespace OneWire::crc;
-
 namespace OneWire
 {
     namespace RomCommands
     {
-        enum OwRomCmd
-        {
-            ReadRomCmd = 0x33,
-            MatchRomCmd = 0x55,
-            SearchRomCmd = 0xF0,
-            SkipRomCmd = 0xCC,
-            ResumeCmd = 0xA5,
-            OverdriveSkipRomCmd = 0x3C,
-            OverdriveMatchRomCmd = 0x69,
-            AlarmSearchCmd = 0xEC
-        };
-        
         void SearchState::reset()
         {
             last_discrepancy = 0;
@@ -95,6 +81,8 @@ namespace OneWire
 
         OneWireMaster::CmdResult OWVerify(OneWireMaster & master, const RomId & romId)
         {
+            OneWireMaster::Lock busLock(master);
+            
             OneWireMaster::CmdResult result;
             SearchState searchState;
 
@@ -119,6 +107,8 @@ namespace OneWire
 
         OneWireMaster::CmdResult OWReadRom(OneWireMaster & master, RomId & romId)
         {
+            OneWireMaster::Lock busLock(master);
+            
             OneWireMaster::CmdResult result;
             RomId readId;
 
@@ -152,38 +142,24 @@ namespace OneWire
         
         OneWireMaster::CmdResult OWSkipRom(OneWireMaster & master)
         {
-            OneWireMaster::CmdResult result;
-
-            result = master.OWReset();
-            if (result == OneWireMaster::Success)
-            {
-                result = master.OWWriteByte(SkipRomCmd);
-            }
-
-            return result;
+            OneWireMaster::Lock busLock(master);
+            
+            OneWireMasterRef masterRef(master);
+            return skipRom(masterRef);
         }
         
         OneWireMaster::CmdResult OWMatchRom(OneWireMaster & master, const RomId & romId)
         {
-            OneWireMaster::CmdResult result;
-
-            uint8_t buf[1 + RomId::Buffer::csize];
-
-            // use MatchROM
-            result = master.OWReset();
-            if (result == OneWireMaster::Success)
-            {
-                buf[0] = MatchRomCmd;
-                std::memcpy(&buf[1], romId.buffer.data(), romId.buffer.size());
-                // send command and rom
-                result = master.OWWriteBlock(buf, 1 + romId.buffer.size());
-            }
-
-            return result;
+            OneWireMaster::Lock busLock(master);
+            
+            OneWireMasterRef masterRef(master);
+            return matchRom(masterRef, romId);
         }
         
         OneWireMaster::CmdResult OWOverdriveSkipRom(OneWireMaster & master)
         {
+            OneWireMaster::Lock busLock(master);
+            
             OneWireMaster::CmdResult result = master.OWSetSpeed(OneWireMaster::StandardSpeed);
 
             if (result == OneWireMaster::Success)
@@ -206,6 +182,8 @@ namespace OneWire
           
         OneWireMaster::CmdResult OWOverdriveMatchRom(OneWireMaster & master, const RomId & romId)
         {
+            OneWireMaster::Lock busLock(master);
+            
             OneWireMaster::CmdResult result;
 
             // use overdrive MatchROM
@@ -227,15 +205,10 @@ namespace OneWire
         
         OneWireMaster::CmdResult OWResume(OneWireMaster & master)
         {
-            OneWireMaster::CmdResult result;
-
-            result = master.OWReset();
-            if (result == OneWireMaster::Success)
-            {
-                result = master.OWWriteByte(ResumeCmd);
-            }
-
-            return result;
+            OneWireMaster::Lock busLock(master);
+            
+            OneWireMasterRef masterRef(master);
+            return resume(masterRef);
         }
 
         OneWireMaster::CmdResult OWSearch(OneWireMaster & master, SearchState & searchState)
@@ -261,145 +234,10 @@ namespace OneWire
 
         OneWireMaster::CmdResult OWSearchAll(OneWireMaster & master, SearchState & searchState, bool alarmSearch)
         {
-            uint8_t id_bit_number;
-            uint8_t last_zero, rom_byte_number;
-            uint8_t id_bit, cmp_id_bit;
-            uint8_t rom_byte_mask;
-            bool search_result;
-            uint8_t crc8 = 0;
-            OneWireMaster::SearchDirection search_direction;
-
-            // initialize for search
-            id_bit_number = 1;
-            last_zero = 0;
-            rom_byte_number = 0;
-            rom_byte_mask = 1;
-            search_result = false;
-
-            // if the last call was not the last one
-            if (!searchState.last_device_flag)
-            {
-                // 1-Wire reset
-                OneWireMaster::CmdResult result = master.OWReset();
-                if (result != OneWireMaster::Success)
-                {
-                    // reset the search
-                    searchState.reset();
-                    return result;
-                }
-
-                // issue the search command 
-                if(alarmSearch){
-                    master.OWWriteByte(AlarmSearchCmd);
-                }
-                else{
-                    master.OWWriteByte(SearchRomCmd);
-                }
-
-                // loop to do the search
-                do
-                {
-                    // if this discrepancy if before the Last Discrepancy
-                    // on a previous next then pick the same as last time
-                    if (id_bit_number < searchState.last_discrepancy)
-                    {
-                        if ((searchState.romId.buffer[rom_byte_number] & rom_byte_mask) > 0)
-                        {
-                            search_direction = OneWireMaster::WriteOne;
-                        }
-                        else
-                        {
-                            search_direction = OneWireMaster::WriteZero;
-                        }
-                    }
-                    else
-                    {
-                        // if equal to last pick 1, if not then pick 0
-                        if (id_bit_number == searchState.last_discrepancy)
-                        {
-                            search_direction = OneWireMaster::WriteOne;
-                        }
-                        else
-                        {
-                            search_direction = OneWireMaster::WriteZero;
-                        }
-                    }
-
-                    // Peform a triple operation on the DS2465 which will perform 2 read bits and 1 write bit
-                    result = master.OWTriplet(search_direction, id_bit, cmp_id_bit);
-                    if (result != OneWireMaster::Success)
-                    {
-                        return result;
-                    }
-
-                    // check for no devices on 1-wire
-                    if (id_bit && cmp_id_bit)
-                    {
-                        break;
-                    }
-                    else
-                    {
-                        if (!id_bit && !cmp_id_bit && (search_direction == OneWireMaster::WriteZero))
-                        {
-                            last_zero = id_bit_number;
-
-                            // check for Last discrepancy in family
-                            if (last_zero < 9)
-                            {
-                                searchState.last_family_discrepancy = last_zero;
-                            }
-                        }
-
-                        // set or clear the bit in the ROM byte rom_byte_number
-                        // with mask rom_byte_mask
-                        if (search_direction == OneWireMaster::WriteOne)
-                        {
-                            searchState.romId.buffer[rom_byte_number] |= rom_byte_mask;
-                        }
-                        else
-                        {
-                            searchState.romId.buffer[rom_byte_number] &= (uint8_t)~rom_byte_mask;
-                        }
-
-                        // increment the byte counter id_bit_number
-                        // and shift the mask rom_byte_mask
-                        id_bit_number++;
-                        rom_byte_mask <<= 1;
-
-                        // if the mask is 0 then go to new SerialNum byte rom_byte_number and reset mask
-                        if (rom_byte_mask == 0)
-                        {
-                            crc8 = calculateCrc8(crc8, searchState.romId.buffer[rom_byte_number]);  // accumulate the CRC
-                            rom_byte_number++;
-                            rom_byte_mask = 1;
-                        }
-                    }
-                } while (rom_byte_number < searchState.romId.buffer.size());  // loop until through all ROM bytes 0-7
-
-                // if the search was successful then
-                if (!((id_bit_number <= (searchState.romId.buffer.size() * 8)) || (crc8 != 0)))
-                {
-                    // search successful so set m_last_discrepancy,m_last_device_flag,search_result
-                    searchState.last_discrepancy = last_zero;
-
-                    // check for last device
-                    if (searchState.last_discrepancy == 0)
-                    {
-                        searchState.last_device_flag = true;
-                    }
-
-                    search_result = true;
-                }
-            }
-
-            // if no device found then reset counters so next 'search' will be like a first
-            if (!search_result || (searchState.romId.familyCode() == 0))
-            {
-                searchState.reset();
-                search_result = false;
-            }
-
-            return (search_result ? OneWireMaster::Success : OneWireMaster::OperationFailure);
+            OneWireMaster::Lock busLock(master);
+            
+            OneWireMasterRef masterRef(master);
+            return searchAll(masterRef, searchState, alarmSearch);
         }
     }
 }
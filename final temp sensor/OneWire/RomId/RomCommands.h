@@ -133,4 +133,6 @@ namespace OneWire
     }
 }
 
+#include "RomId/BasicRomCommands.h"
+
 #endif
@@ -68,6 +68,11 @@ OneWireMaster::CmdResult ForwardSearchRomIterator::selectNextFamilyDevice()
     return OWNext(master(), searchState);
 }
 
+OneWireMaster::CmdResult RandomAccessRomIterator::selectAllDevices()
+{
+    return OWSkipRom(master());
+}
+
 OneWireMaster::CmdResult SingledropRomIterator::selectDevice(const RomId &)
 {
     return selectDevice();
@@ -94,3 +99,9 @@ OneWireMaster::CmdResult MultidropRomIteratorWithResume::selectDevice(const RomI
     
     return result;
 }
+
+OneWireMaster::CmdResult MultidropRomIteratorWithResume::selectAllDevices()
+{
+    lastRom = RomId();
+    return OWSkipRom(master());
+}
@@ -113,6 +113,9 @@ namespace OneWire
         
         /// Select the device with the given ROM ID.
         virtual OneWireMaster::CmdResult selectDevice(const RomId & romId) = 0;
+        
+        /// Select every device on the bus for a broadcast command.
+        virtual OneWireMaster::CmdResult selectAllDevices();
     };
     
     /// Iterator for a singledrop 1-Wire bus.
@@ -149,6 +152,9 @@ namespace OneWire
             : RandomAccessRomIterator(master), lastRom() { }
         
         virtual OneWireMaster::CmdResult selectDevice(const RomId & romId);
+        
+        /// Skip ROM clears the Resume flag on every slave so the next selection must use Match ROM.
+        virtual OneWireMaster::CmdResult selectAllDevices();
     };
 }
 
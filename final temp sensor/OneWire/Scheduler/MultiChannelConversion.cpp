@@ -0,0 +1,171 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Scheduler/MultiChannelConversion.h"
+#include "wait_api.h"
+#include "us_ticker_api.h"
+
+
+using namespace OneWire;
+
+
+static const uint8_t numChannels = DS2482EightChannel::channels;
+
+
+/**********************************************************************/
+MultiChannelConversion::MultiChannelConversion(DS2482ChannelRomIterator & selector)
+: m_selector(selector), m_concurrentChannels(0), m_parasiteChannels(0)
+{
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult MultiChannelConversion::convertAll(DS18B20 * const * sensors, size_t numSensors, int16_t * temps)
+{
+    OneWireMaster::Lock busLock(m_selector.master());
+    
+    m_concurrentChannels = 0;
+    m_parasiteChannels = 0;
+    
+    //Slowest resolution of the sensors on each channel
+    bool used[numChannels];
+    DS18B20::Resolution slowestRes[numChannels];
+    for (uint8_t ch = 0; ch < numChannels; ch++)
+    {
+        used[ch] = false;
+        slowestRes[ch] = DS18B20::NineBit;
+    }
+    
+    for (size_t idx = 0; idx < numSensors; idx++)
+    {
+        uint8_t ch;
+        if (!m_selector.findChannel(sensors[idx]->romId(), ch))
+        {
+            return OneWireSlave::OperationFailure;
+        }
+        used[ch] = true;
+        if (DS18B20::conversionTimeUs(sensors[idx]->resolution()) > DS18B20::conversionTimeUs(slowestRes[ch]))
+        {
+            slowestRes[ch] = sensors[idx]->resolution();
+        }
+    }
+    
+    //Start every channel that can be left converting
+    bool parasite[numChannels];
+    const uint32_t startUs = us_ticker_read();
+    uint32_t lastDoneUs = 0;
+    for (uint8_t ch = 0; ch < numChannels; ch++)
+    {
+        parasite[ch] = false;
+        if (!used[ch])
+        {
+            continue;
+        }
+        
+        if (m_selector.selectChannel(ch) != OneWireMaster::Success)
+        {
+            return OneWireSlave::CommunicationError;
+        }
+        
+        OneWireSlave::CmdResult deviceResult = DS18B20::startConversionAll(m_selector);
+        if (deviceResult == OneWireSlave::Success)
+        {
+            uint32_t doneUs = ((us_ticker_read() - startUs) + DS18B20::conversionTimeUs(slowestRes[ch]));
+            if (doneUs > lastDoneUs)
+            {
+                lastDoneUs = doneUs;
+            }
+            m_concurrentChannels++;
+        }
+        else if (deviceResult == OneWireSlave::OperationFailure)
+        {
+            parasite[ch] = true;
+        }
+        else
+        {
+            return deviceResult;
+        }
+    }
+    
+    //Parasite powered channels hold the bus while the others convert
+    for (uint8_t ch = 0; ch < numChannels; ch++)
+    {
+        if (!parasite[ch])
+        {
+            continue;
+        }
+        
+        if (m_selector.selectChannel(ch) != OneWireMaster::Success)
+        {
+            return OneWireSlave::CommunicationError;
+        }
+        
+        //startConversionAll() already found a parasite powered device
+        OneWireSlave::CmdResult deviceResult = DS18B20::convertTemperatureAll(m_selector, slowestRes[ch], false);
+        if (deviceResult != OneWireSlave::Success)
+        {
+            return deviceResult;
+        }
+        m_parasiteChannels++;
+    }
+    
+    uint32_t elapsedUs = (us_ticker_read() - startUs);
+    if (elapsedUs < lastDoneUs)
+    {
+        uint32_t remainingUs = (lastDoneUs - elapsedUs);
+        wait_ms(remainingUs / 1000);
+        wait_us(remainingUs % 1000);
+    }
+    
+    //Read channel by channel so that each channel is selected once
+    OneWireSlave::CmdResult result = OneWireSlave::Success;
+    for (uint8_t ch = 0; ch < numChannels; ch++)
+    {
+        for (size_t idx = 0; used[ch] && (idx < numSensors); idx++)
+        {
+            uint8_t sensorCh = numChannels;
+            m_selector.findChannel(sensors[idx]->romId(), sensorCh);
+            if (sensorCh != ch)
+            {
+                continue;
+            }
+            
+            OneWireSlave::CmdResult deviceResult = sensors[idx]->readTemperature(temps[idx]);
+            if ((deviceResult != OneWireSlave::Success) && (result == OneWireSlave::Success))
+            {
+                result = deviceResult;
+            }
+        }
+    }
+    
+    return result;
+}
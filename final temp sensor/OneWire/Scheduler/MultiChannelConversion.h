@@ -0,0 +1,108 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Scheduler_MultiChannelConversion
+#define OneWire_Scheduler_MultiChannelConversion
+
+#include "Masters/DS248x/DS2482EightChannel/DS2482ChannelRomIterator.h"
+#include "Slaves/Sensors/DS18B20/DS18B20.h"
+
+namespace OneWire
+{
+    /**
+    * @brief DS18B20 conversions interleaved across DS2482-800 channels
+    *
+    * @details Treats the eight channels of a DS2482-800 as independent
+    * buses. A conversion is started on every channel whose sensors are
+    * all locally powered before any result is read, so their conversion
+    * times overlap. A channel with a parasite powered sensor holds the 
+    * strong pullup for its conversion, which is run while the locally 
+    * powered channels convert. Results are then read channel by channel 
+    * so that each channel is selected only once.
+    *
+    * @code
+    * DS2482EightChannel owm(i2c, DS2482EightChannel::I2C_ADRS0);
+    * DS2482ChannelRomIterator selector(owm);
+    * selector.discover();
+    * DS18B20 probeA(selector), probeB(selector);
+    * DS18B20 * probes[] = { &probeA, &probeB };
+    * int16_t temps[2];
+    * MultiChannelConversion conversion(selector);
+    * conversion.convertAll(probes, 2, temps);
+    * @endcode
+    */
+    class MultiChannelConversion
+    {
+    public:
+        
+        /// @param selector Iterator shared with the sensor drivers, 
+        /// its map must hold the channel of every sensor.
+        MultiChannelConversion(DS2482ChannelRomIterator & selector);
+        
+        
+        /**********************************************************//**
+        * @brief Convert All
+        *
+        * @details Converts the temperature of every given sensor and
+        * reads the results. Every device on a channel that holds one
+        * of the sensors converts as well.
+        *
+        * On Entry:
+        * @param[in] sensors - sensors with their ROM ID set
+        * @param[in] numSensors - number of sensors
+        *
+        * On Exit:
+        * @param[out] temps - temperature of each sensor in 1/16 degree
+        * Celsius units
+        *
+        * @return CmdResult - result of operation, the first failure if
+        * any sensor could not be read, OperationFailure if a sensor is
+        * not in the channel map
+        **************************************************************/
+        OneWireSlave::CmdResult convertAll(DS18B20 * const * sensors, size_t numSensors, int16_t * temps);
+        
+        
+        ///Channels converted concurrently by the last convertAll()
+        uint8_t concurrentChannels() const { return m_concurrentChannels; }
+        
+        ///Channels converted on the strong pullup by the last convertAll()
+        uint8_t parasiteChannels() const { return m_parasiteChannels; }
+        
+    private:
+        
+        DS2482ChannelRomIterator & m_selector;
+        uint8_t m_concurrentChannels;
+        uint8_t m_parasiteChannels;
+    };
+}
+
+#endif /* OneWire_Scheduler_MultiChannelConversion */
@@ -0,0 +1,319 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Scheduler/OneWireScheduler.h"
+#include "us_ticker_api.h"
+
+
+using namespace OneWire;
+
+
+/// Effective priority of an operation whose deadline has passed.
+static const unsigned int LATE_PRIORITY = 0x100;
+
+
+/// True once nowMs has reached targetMs, tolerates timer wrap.
+static bool timeReached(uint32_t nowMs, uint32_t targetMs)
+{
+    return (static_cast<int32_t>(nowMs - targetMs) >= 0);
+}
+
+
+/**********************************************************************/
+OneWireScheduler::Operation::Operation(const RomId & romId)
+: m_romId(romId), m_next(NULL), m_state(Idle), m_result(OneWireSlave::Success), 
+  m_priority(NormalPriority), m_hasDeadline(false), m_deadlineMs(0), m_readyMs(0), 
+  m_preemptions(0)
+{
+}
+
+
+/**********************************************************************/
+OneWireScheduler::OneWireScheduler(RandomAccessRomIterator & selector)
+: m_selector(selector), m_queue(NULL), m_waiting(NULL), m_lastRom(), 
+  m_preemptPriority(UrgentPriority), m_preemptions(0)
+{
+}
+
+
+/**********************************************************************/
+bool OneWireScheduler::submit(Operation & op, uint32_t nowMs, uint8_t priority, uint32_t deadlineMs)
+{
+    bool result = ((op.m_state == Operation::Idle) || (op.m_state == Operation::Complete));
+    
+    if (result)
+    {
+        op.m_priority = priority;
+        op.m_hasDeadline = (deadlineMs != noDeadline);
+        op.m_deadlineMs = (nowMs + deadlineMs);
+        op.m_preemptions = 0;
+        enqueue(op);
+    }
+    
+    return result;
+}
+
+
+/**********************************************************************/
+bool OneWireScheduler::cancel(Operation & op)
+{
+    bool result = ((op.m_state == Operation::Queued) && unlink(m_queue, op));
+    
+    if (result)
+    {
+        op.m_state = Operation::Idle;
+    }
+    
+    return result;
+}
+
+
+/**********************************************************************/
+void OneWireScheduler::poll(uint32_t nowMs)
+{
+    OneWireMaster::Lock busLock(m_selector.master());
+    
+    uint32_t pollStartUs = us_ticker_read();
+    
+    Operation * op = m_waiting;
+    while (op != NULL)
+    {
+        Operation * next = op->m_next;
+        if (timeReached(nowMs, op->m_readyMs))
+        {
+            unlink(m_waiting, *op);
+            completeOperation(*op, op->finish());
+        }
+        op = next;
+    }
+    
+    while ((op = nextOperation(nowMs)) != NULL)
+    {
+        Operation * holder = busHolder();
+        if (holder != NULL)
+        {
+            if (!canPreempt(*op, *holder, nowMs))
+            {
+                break;
+            }
+            
+            //Give up the pullup now, the conversion restarts after op
+            unlink(m_waiting, *holder);
+            holder->abort();
+            holder->m_preemptions++;
+            m_preemptions++;
+            enqueue(*holder);
+        }
+        
+        unlink(m_queue, *op);
+        m_lastRom = op->m_romId;
+        
+        uint32_t waitMs = 0;
+        OneWireSlave::CmdResult result = op->start(waitMs);
+        if ((result == OneWireSlave::Success) && (waitMs > 0))
+        {
+            //nowMs does not include the bus time of this poll so far
+            uint32_t elapsedMs = ((us_ticker_read() - pollStartUs + 999) / 1000);
+            op->m_state = Operation::Waiting;
+            op->m_readyMs = (nowMs + elapsedMs + waitMs);
+            op->m_next = m_waiting;
+            m_waiting = op;
+        }
+        else
+        {
+            completeOperation(*op, result);
+        }
+    }
+}
+
+
+/**********************************************************************/
+uint32_t OneWireScheduler::msUntilNextPoll(uint32_t nowMs) const
+{
+    uint32_t waitMs = 0xFFFFFFFF;
+    const Operation * holder = busHolder();
+    
+    for (const Operation * op = m_queue; op != NULL; op = op->m_next)
+    {
+        if ((holder == NULL) || canPreempt(*op, *holder, nowMs))
+        {
+            return 0;
+        }
+        
+        //A late operation may preempt the holder
+        if (op->m_hasDeadline && ((op->m_deadlineMs - nowMs) < waitMs))
+        {
+            waitMs = (op->m_deadlineMs - nowMs);
+        }
+    }
+    
+    for (const Operation * op = m_waiting; op != NULL; op = op->m_next)
+    {
+        uint32_t opWaitMs = timeReached(nowMs, op->m_readyMs) ? 0 : (op->m_readyMs - nowMs);
+        if (opWaitMs < waitMs)
+        {
+            waitMs = opWaitMs;
+        }
+    }
+    
+    return waitMs;
+}
+
+
+/**********************************************************************/
+OneWireScheduler::Operation * OneWireScheduler::busHolder() const
+{
+    Operation * op = m_waiting;
+    while ((op != NULL) && !op->holdsBus())
+    {
+        op = op->m_next;
+    }
+    
+    return op;
+}
+
+
+/**********************************************************************/
+OneWireScheduler::Operation * OneWireScheduler::nextOperation(uint32_t nowMs) const
+{
+    Operation * best = m_queue;
+    
+    if (best != NULL)
+    {
+        for (Operation * op = best->m_next; op != NULL; op = op->m_next)
+        {
+            if (runsBefore(*op, *best, nowMs))
+            {
+                best = op;
+            }
+        }
+    }
+    
+    return best;
+}
+
+
+/**********************************************************************/
+bool OneWireScheduler::canPreempt(const Operation & op, const Operation & holder, uint32_t nowMs) const
+{
+    unsigned int priority = effectivePriority(op, nowMs);
+    
+    return ((priority >= m_preemptPriority) && (priority > holder.m_priority));
+}
+
+
+/**********************************************************************/
+unsigned int OneWireScheduler::effectivePriority(const Operation & op, uint32_t nowMs) const
+{
+    unsigned int priority = op.m_priority;
+    
+    if (op.m_hasDeadline && timeReached(nowMs, op.m_deadlineMs))
+    {
+        priority = LATE_PRIORITY;
+    }
+    
+    return priority;
+}
+
+
+/**********************************************************************/
+bool OneWireScheduler::runsBefore(const Operation & lhs, const Operation & rhs, uint32_t nowMs) const
+{
+    unsigned int lhsPriority = effectivePriority(lhs, nowMs);
+    unsigned int rhsPriority = effectivePriority(rhs, nowMs);
+    
+    if (lhsPriority != rhsPriority)
+    {
+        return (lhsPriority > rhsPriority);
+    }
+    
+    //Stay on the selected device so the next selection is a Resume ROM
+    bool lhsSelected = (lhs.m_romId == m_lastRom);
+    bool rhsSelected = (rhs.m_romId == m_lastRom);
+    if (lhsSelected != rhsSelected)
+    {
+        return lhsSelected;
+    }
+    
+    if (lhs.m_hasDeadline != rhs.m_hasDeadline)
+    {
+        return lhs.m_hasDeadline;
+    }
+    
+    //Earliest deadline first, otherwise in order of submission
+    return (lhs.m_hasDeadline && (static_cast<int32_t>(lhs.m_deadlineMs - rhs.m_deadlineMs) < 0));
+}
+
+
+/**********************************************************************/
+void OneWireScheduler::enqueue(Operation & op)
+{
+    op.m_state = Operation::Queued;
+    op.m_next = NULL;
+    
+    Operation ** tail = &m_queue;
+    while (*tail != NULL)
+    {
+        tail = &((*tail)->m_next);
+    }
+    *tail = &op;
+}
+
+
+/**********************************************************************/
+bool OneWireScheduler::unlink(Operation * & list, Operation & op)
+{
+    Operation ** link = &list;
+    while ((*link != NULL) && (*link != &op))
+    {
+        link = &((*link)->m_next);
+    }
+    
+    bool result = (*link != NULL);
+    if (result)
+    {
+        *link = op.m_next;
+        op.m_next = NULL;
+    }
+    
+    return result;
+}
+
+
+/**********************************************************************/
+void OneWireScheduler::completeOperation(Operation & op, OneWireSlave::CmdResult result)
+{
+    op.m_state = Operation::Complete;
+    op.m_result = result;
+    op.m_next = NULL;
+    op.completed();
+}
@@ -0,0 +1,263 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Scheduler_OneWireScheduler
+#define OneWire_Scheduler_OneWireScheduler
+
+#include "RomId/RomIterator.h"
+#include "Slaves/OneWireSlave.h"
+
+namespace OneWire
+{
+    /**
+    * @brief Prioritized transaction scheduler for a shared 1-Wire bus
+    *
+    * @details Slave drivers queue operations with a priority and an 
+    * optional deadline, poll() then runs them in order of priority. An
+    * operation whose deadline has passed is run before all others. 
+    * Among operations of equal priority those for the last selected 
+    * device are run first. On a bus where every device supports Resume
+    * ROM and the drivers share a MultidropRomIteratorWithResume, a group
+    * of operations to the same device then costs one Match ROM followed
+    * by Resume ROM for the rest.
+    *
+    * Operations may be split-phase, such as a temperature conversion: 
+    * start() begins the operation and returns a wait time, finish() 
+    * completes it once that time has elapsed. Other operations run in 
+    * the meantime unless the operation holds the bus on the strong 
+    * pullup. An operation at or above the preemption priority that 
+    * outranks the holding operation aborts it, releasing the pullup, 
+    * and the aborted operation is queued again to restart afterwards.
+    *
+    * poll() never waits for a split-phase operation, call it 
+    * periodically with the current time in ms from any monotonic source.
+    *
+    * @code
+    * class PioWrite : public OneWireScheduler::Operation
+    * {
+    * public:
+    *     PioWrite(DS2413 & pio, uint8_t val) 
+    *     : Operation(pio.romId()), m_pio(pio), m_val(val) { }
+    * protected:
+    *     virtual OneWireSlave::CmdResult start(uint32_t & waitMs) { ... }
+    * };
+    *
+    * MultidropRomIterator selector(owm);
+    * OneWireScheduler scheduler(selector);
+    * ScheduledConversion conversion(probe);
+    * scheduler.submit(conversion, nowMs());
+    * scheduler.submit(pioWrite, nowMs(), OneWireScheduler::UrgentPriority, 10);
+    * while (true)
+    * {
+    *     scheduler.poll(nowMs());
+    * }
+    * @endcode
+    */
+    class OneWireScheduler
+    {
+    public:
+        
+        ///Common priorities, any value from 0 to 255 may be used
+        enum Priority
+        {
+            LowPriority = 0,
+            NormalPriority = 64,
+            HighPriority = 128,
+            UrgentPriority = 192
+        };
+        
+        ///Deadline of an operation that has none
+        static const uint32_t noDeadline = 0xFFFFFFFF;
+        
+        /// Unit of work queued on the scheduler.
+        class Operation
+        {
+        public:
+            
+            enum State
+            {
+                Idle,
+                Queued,
+                Waiting,
+                Complete
+            };
+            
+            /// @{
+            /// Progress and result of the operation.
+            State state() const { return m_state; }
+            bool complete() const { return (m_state == Complete); }
+            OneWireSlave::CmdResult result() const { return m_result; }
+            /// @}
+            
+            /// ROM ID of the device this operation selects.
+            const RomId & romId() const { return m_romId; }
+            
+            /// Priority the operation was submitted with.
+            uint8_t priority() const { return m_priority; }
+            
+            /// Number of times the operation was aborted and restarted.
+            uint32_t preemptions() const { return m_preemptions; }
+            
+        protected:
+            /// @param romId ROM ID of the device this operation selects.
+            Operation(const RomId & romId);
+            
+            ~Operation() { }
+            
+            /// Begin the operation, the bus lock is held by the caller.
+            /// @param[out] waitMs Time until finish() may be called, 
+            /// 0 if the operation is already complete.
+            virtual OneWireSlave::CmdResult start(uint32_t & waitMs) = 0;
+            
+            /// True while a started operation holds the bus.
+            virtual bool holdsBus() const { return false; }
+            
+            /// Complete a split-phase operation once its wait has elapsed.
+            virtual OneWireSlave::CmdResult finish() { return OneWireSlave::Success; }
+            
+            /// Abandon a started operation that holds the bus, it is 
+            /// started again later.
+            virtual void abort() { }
+            
+            /// Called once the operation has completed.
+            virtual void completed() { }
+            
+        private:
+            friend class OneWireScheduler;
+            
+            RomId m_romId;
+            Operation * m_next;
+            State m_state;
+            OneWireSlave::CmdResult m_result;
+            uint8_t m_priority;
+            bool m_hasDeadline;
+            uint32_t m_deadlineMs;
+            uint32_t m_readyMs;
+            uint32_t m_preemptions;
+        };
+        
+        /**********************************************************//**
+        * @brief OneWireScheduler constructor
+        *
+        * @details
+        *
+        * On Entry:
+        * @param[in] selector - Reference to RandomAccessRomIterator 
+        * shared with the slave drivers of the queued operations
+        *
+        * On Exit:
+        *
+        * @return
+        **************************************************************/
+        OneWireScheduler(RandomAccessRomIterator & selector);
+        
+        
+        /**********************************************************//**
+        * @brief Submit
+        *
+        * @details Queues an operation. The operation must stay valid 
+        * until it has completed or has been cancelled.
+        *
+        * On Entry:
+        * @param[in] op - operation to queue
+        * @param[in] nowMs - current time in ms
+        * @param[in] priority - higher values run first
+        * @param[in] deadlineMs - time in ms from now after which the 
+        * operation runs ahead of all others, or noDeadline
+        *
+        * On Exit:
+        *
+        * @return bool - false if the operation is already queued or 
+        * running
+        **************************************************************/
+        bool submit(Operation & op, uint32_t nowMs, uint8_t priority = NormalPriority, uint32_t deadlineMs = noDeadline);
+        
+        
+        ///Remove an operation that has not been started yet, returns 
+        ///false if it is not queued
+        bool cancel(Operation & op);
+        
+        
+        /**********************************************************//**
+        * @brief Poll
+        *
+        * @details Finishes split-phase operations whose wait has 
+        * elapsed and starts queued operations until the queue is empty
+        * or an operation holds the bus.
+        *
+        * On Entry:
+        * @param[in] nowMs - current time in ms
+        *
+        * On Exit:
+        *
+        * @return
+        **************************************************************/
+        void poll(uint32_t nowMs);
+        
+        
+        ///Operations that may preempt a holding operation need at least 
+        ///this priority, default is UrgentPriority
+        void setPreemptPriority(uint8_t priority) { m_preemptPriority = priority; }
+        
+        ///True while a started operation holds the bus
+        bool busy() const { return (busHolder() != NULL); }
+        
+        ///True if no operations are queued or running
+        bool idle() const { return ((m_queue == NULL) && (m_waiting == NULL)); }
+        
+        ///Time in ms until poll() next has work to do
+        uint32_t msUntilNextPoll(uint32_t nowMs) const;
+        
+        ///Number of operations aborted to free the bus
+        uint32_t preemptions() const { return m_preemptions; }
+        
+    private:
+        
+        RandomAccessRomIterator & m_selector;
+        Operation * m_queue;
+        Operation * m_waiting;
+        RomId m_lastRom;
+        uint8_t m_preemptPriority;
+        uint32_t m_preemptions;
+        
+        Operation * busHolder() const;
+        Operation * nextOperation(uint32_t nowMs) const;
+        bool canPreempt(const Operation & op, const Operation & holder, uint32_t nowMs) const;
+        unsigned int effectivePriority(const Operation & op, uint32_t nowMs) const;
+        bool runsBefore(const Operation & lhs, const Operation & rhs, uint32_t nowMs) const;
+        void enqueue(Operation & op);
+        static bool unlink(Operation * & list, Operation & op);
+        void completeOperation(Operation & op, OneWireSlave::CmdResult result);
+    };
+}
+
+#endif /* OneWire_Scheduler_OneWireScheduler */
@@ -0,0 +1,75 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#include "Scheduler/ScheduledConversion.h"
+
+
+using namespace OneWire;
+
+
+/**********************************************************************/
+ScheduledConversion::ScheduledConversion(DS18B20 & sensor)
+: OneWireScheduler::Operation(sensor.romId()), m_sensor(sensor), m_temperature(0)
+{
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult ScheduledConversion::start(uint32_t & waitMs)
+{
+    OneWireSlave::CmdResult result = m_sensor.startConversion();
+    
+    waitMs = ((DS18B20::conversionTimeUs(m_sensor.resolution()) + 999) / 1000);
+    
+    return result;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult ScheduledConversion::finish()
+{
+    OneWireSlave::CmdResult result = m_sensor.endConversion();
+    
+    if (result == OneWireSlave::Success)
+    {
+        result = m_sensor.readTemperature(m_temperature);
+    }
+    
+    return result;
+}
+
+
+/**********************************************************************/
+void ScheduledConversion::abort()
+{
+    m_sensor.endConversion();
+}
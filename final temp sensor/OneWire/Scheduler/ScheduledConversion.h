@@ -0,0 +1,72 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Scheduler_ScheduledConversion
+#define OneWire_Scheduler_ScheduledConversion
+
+#include "Scheduler/OneWireScheduler.h"
+#include "Slaves/Sensors/DS18B20/DS18B20.h"
+
+namespace OneWire
+{
+    /**
+    * @brief DS18B20 temperature conversion as a scheduler operation
+    *
+    * @details Starts the conversion with DS18B20::startConversion() and
+    * reads the temperature once the conversion time of the sensor's 
+    * resolution has elapsed. A locally powered sensor leaves the bus 
+    * free for other operations meanwhile, a parasite powered sensor 
+    * holds it on the strong pullup and may be preempted.
+    */
+    class ScheduledConversion : public OneWireScheduler::Operation
+    {
+    public:
+        
+        /// @param sensor Sensor with its ROM ID set, must outlive the operation.
+        ScheduledConversion(DS18B20 & sensor);
+        
+        /// Temperature in 1/16 degree Celsius units, valid once complete with Success.
+        int16_t temperature() const { return m_temperature; }
+        
+    protected:
+        virtual OneWireSlave::CmdResult start(uint32_t & waitMs);
+        virtual bool holdsBus() const { return m_sensor.conversionHoldsBus(); }
+        virtual OneWireSlave::CmdResult finish();
+        virtual void abort();
+        
+    private:
+        DS18B20 & m_sensor;
+        int16_t m_temperature;
+    };
+}
+
+#endif /* OneWire_Scheduler_ScheduledConversion */
@@ -154,6 +154,8 @@ DS28E15_22_25::DS28E15_22_25(RandomAccessRomIterator & selector, bool lowVoltage
 
 OneWireSlave::CmdResult DS28E15_22_25::writeAuthBlockProtection(const ISha256MacCoproc & MacCoproc, const BlockProtection & newProtection, const BlockProtection & oldProtection)
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256], cs;
     int cnt = 0;
     Mac mac;
@@ -237,6 +239,8 @@ OneWireSlave::CmdResult DS28E15_22_25::writeAuthBlockProtection(const ISha256Mac
 
 OneWireSlave::CmdResult DS28E15_22_25::writeBlockProtection(const BlockProtection & protection)
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256], cs;
     int cnt = 0;
     
@@ -311,6 +315,8 @@ OneWireSlave::CmdResult DS28E15_22_25::doReadPersonality(Personality & personali
 template <class T>
 OneWireSlave::CmdResult DS28E15_22_25::readStatus(bool personality, bool allpages, unsigned int blockNum, uint8_t * rdbuf) const
 {
+    OneWireMaster::Lock busLock(master());
+    
     const size_t crcLen = 4, ds28e22_25_pagesPerBlock = 2;
 
     uint8_t buf[256];
@@ -434,6 +440,8 @@ ISha256MacCoproc::CmdResult DS28E15_22_25::computeAuthMacAnon(const ISha256MacCo
 
 OneWireSlave::CmdResult DS28E15_22_25::computeReadPageMac(unsigned int page_num, bool anon, Mac & mac) const
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256], cs;
     int cnt = 0;
     
@@ -490,6 +498,8 @@ OneWireSlave::CmdResult DS28E15_22_25::computeReadPageMac(unsigned int page_num,
 
 OneWireSlave::CmdResult DS28E15_22_25::computeSecret(unsigned int page_num, bool lock)
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256], cs;
     int cnt = 0;
     
@@ -537,6 +547,8 @@ OneWireSlave::CmdResult DS28E15_22_25::computeSecret(unsigned int page_num, bool
 template <class T>
 OneWireSlave::CmdResult DS28E15_22_25::doWriteScratchpad(const Scratchpad & data) const
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256];
     int cnt = 0, offset;
     
@@ -593,6 +605,8 @@ OneWireSlave::CmdResult DS28E15_22_25::doWriteScratchpad(const Scratchpad & data
 template <class T>
 OneWireSlave::CmdResult DS28E15_22_25::doReadScratchpad(Scratchpad & data) const
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256];
     int cnt = 0, offset;
     
@@ -648,6 +662,8 @@ OneWireSlave::CmdResult DS28E15_22_25::doReadScratchpad(Scratchpad & data) const
 
 OneWireSlave::CmdResult DS28E15_22_25::loadSecret(bool lock)
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256], cs;
     int cnt = 0;
     
@@ -694,6 +710,8 @@ OneWireSlave::CmdResult DS28E15_22_25::loadSecret(bool lock)
 
 OneWireSlave::CmdResult DS28E15_22_25::readPage(unsigned int page, Page & rdbuf, bool continuing) const
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256];
     int cnt = 0;
     int offset = 0;
@@ -747,6 +765,8 @@ OneWireSlave::CmdResult DS28E15_22_25::readPage(unsigned int page, Page & rdbuf,
 template <class T>
 OneWireSlave::CmdResult DS28E15_22_25::doWriteAuthSegmentMac(unsigned int pageNum, unsigned int segmentNum, const Segment & newData, const Mac & mac, bool continuing)
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256], cs;
     int cnt, offset;
 
@@ -920,6 +940,8 @@ ISha256MacCoproc::CmdResult DS28E15_22_25::computeProtectionWriteMac(const ISha2
 template <class T>
 OneWireSlave::CmdResult DS28E15_22_25::doWriteAuthSegment(const ISha256MacCoproc & MacCoproc, unsigned int pageNum, unsigned int segmentNum, const Segment & newData, const Segment & oldData, bool continuing)
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256], cs;
     int cnt, offset;
 
@@ -1049,6 +1071,8 @@ OneWireSlave::CmdResult DS28E15_22_25::doWriteAuthSegment(const ISha256MacCoproc
 
 OneWireSlave::CmdResult DS28E15_22_25::readSegment(unsigned int page, unsigned int segment, Segment & data, bool continuing) const
 {
+    OneWireMaster::Lock busLock(master());
+    
     OneWireMaster::CmdResult result = OneWireMaster::OperationFailure;
     uint8_t buf[2];
 
@@ -1085,6 +1109,8 @@ OneWireSlave::CmdResult DS28E15_22_25::readSegment(unsigned int page, unsigned i
 
 OneWireSlave::CmdResult DS28E15_22_25::writeSegment(unsigned int page, unsigned int block, const Segment & data, bool continuing)
 {
+    OneWireMaster::Lock busLock(master());
+    
     uint8_t buf[256], cs;
     int cnt = 0;
     int offset = 0;
@@ -66,6 +66,8 @@ DS28E17::CmdResult DS28E17::writeDataWithStop(uint8_t I2C_addr, uint8_t length,
                                                   uint8_t *data, uint8_t &status,
                                                   uint8_t &wr_status)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult bridge_result = DS28E17::OperationFailure;
 
     size_t send_cnt = 0;
@@ -117,6 +119,8 @@ DS28E17::CmdResult DS28E17::writeDataNoStop(uint8_t I2C_addr, uint8_t length,
                                                 uint8_t *data, uint8_t &status,
                                                 uint8_t &wr_status)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult bridge_result = DS28E17::OperationFailure;
 
     size_t send_cnt = 0;
@@ -165,6 +169,8 @@ DS28E17::CmdResult DS28E17::writeDataNoStop(uint8_t I2C_addr, uint8_t length,
 DS28E17::CmdResult DS28E17::writeDataOnly(uint8_t length, uint8_t *data,
                                               uint8_t &status, uint8_t &wr_status)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult bridge_result = DS28E17::OperationFailure;
 
     size_t send_cnt = 0;
@@ -211,6 +217,8 @@ DS28E17::CmdResult DS28E17::writeDataOnly(uint8_t length, uint8_t *data,
 DS28E17::CmdResult DS28E17::writeDataOnlyWithStop(uint8_t length, uint8_t *data,
                                                       uint8_t &status, uint8_t &wr_status)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult bridge_result = DS28E17::OperationFailure;
 
     size_t send_cnt = 0;
@@ -259,6 +267,8 @@ DS28E17::CmdResult DS28E17::writeReadDataWithStop(uint8_t I2C_addr, uint8_t leng
                                                       uint8_t &status, uint8_t &wr_status,
                                                       uint8_t *read_data)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult bridge_result = DS28E17::OperationFailure;
 
     size_t send_cnt = 0;
@@ -326,6 +336,8 @@ DS28E17::CmdResult DS28E17::writeReadDataWithStop(uint8_t I2C_addr, uint8_t leng
 DS28E17::CmdResult DS28E17::readDataWithStop(uint8_t I2C_addr, uint8_t nu_bytes_read,
                                                  uint8_t &status, uint8_t *read_data)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult  bridge_result = DS28E17::OperationFailure;
 
     size_t send_cnt = 0;
@@ -380,6 +392,8 @@ DS28E17::CmdResult DS28E17::readDataWithStop(uint8_t I2C_addr, uint8_t nu_bytes_
 //*********************************************************************
 DS28E17::CmdResult DS28E17::writeConfigReg(uint8_t data)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult bridge_result = DS28E17::OperationFailure;
 
     OneWireMaster::CmdResult ow_result = selectDevice();
@@ -407,6 +421,8 @@ DS28E17::CmdResult DS28E17::writeConfigReg(uint8_t data)
 //*********************************************************************
 DS28E17::CmdResult DS28E17::readConfigReg(uint8_t & config)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult bridge_result = DS28E17::OperationFailure;
 
     OneWireMaster::CmdResult ow_result = selectDevice();
@@ -440,6 +456,8 @@ DS28E17::CmdResult DS28E17::readConfigReg(uint8_t & config)
 //*********************************************************************
 DS28E17::CmdResult DS28E17::enableSleepMode()
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult bridge_result = DS28E17::OperationFailure;
 
     OneWireMaster::CmdResult ow_result = selectDevice();
@@ -465,6 +483,8 @@ DS28E17::CmdResult DS28E17::enableSleepMode()
 //*********************************************************************
 DS28E17::CmdResult DS28E17::readDeviceRevision(uint8_t & rev)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS28E17::CmdResult bridge_result = DS28E17::OperationFailure;
 
     OneWireMaster::CmdResult ow_result = selectDevice();
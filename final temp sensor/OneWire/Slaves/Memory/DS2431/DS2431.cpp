@@ -32,6 +32,7 @@
 
 #include "wait_api.h"
 #include "Slaves/Memory/DS2431/DS2431.h"
+#include "Masters/OneWireTransaction.h"
 
 using namespace OneWire;
 using namespace OneWire::crc;
@@ -54,6 +55,8 @@ DS2431::DS2431(RandomAccessRomIterator & selector) : OneWireSlave(selector)
 //*********************************************************************
 OneWireSlave::CmdResult DS2431::writeMemory(Address targetAddress, const Scratchpad & data)
 {    
+    OneWireMaster::Lock busLock(master());
+    
     if (((targetAddress & 0x7) != 0x0) || ((targetAddress + data.size()) > beginReservedAddress))
     {
         return OneWireSlave::OperationFailure;
@@ -77,6 +80,8 @@ OneWireSlave::CmdResult DS2431::writeMemory(Address targetAddress, const Scratch
 //*********************************************************************
 OneWireSlave::CmdResult DS2431::readMemory(Address targetAddress, uint8_t numBytes, uint8_t * data)
 {    
+    OneWireMaster::Lock busLock(master());
+    
     if ((targetAddress + numBytes) > beginReservedAddress)
     {
         return OneWireSlave::OperationFailure;
@@ -104,6 +109,8 @@ OneWireSlave::CmdResult DS2431::readMemory(Address targetAddress, uint8_t numByt
 //*********************************************************************
 OneWireSlave::CmdResult DS2431::writeScratchpad(Address targetAddress, const Scratchpad & data)
 {    
+    OneWireMaster::Lock busLock(master());
+    
     OneWireMaster::CmdResult owmResult = selectDevice();
     if(owmResult != OneWireMaster::Success)
     {
@@ -142,19 +149,22 @@ OneWireSlave::CmdResult DS2431::writeScratchpad(Address targetAddress, const Scr
 //*********************************************************************
 OneWireSlave::CmdResult DS2431::readScratchpad(Scratchpad & data, uint8_t & esByte)
 {    
+    OneWireMaster::Lock busLock(master());
+    
     OneWireMaster::CmdResult owmResult = selectDevice();
     if (owmResult != OneWireMaster::Success)
     {
         return OneWireSlave::CommunicationError;
     }
-    owmResult = master().OWWriteByte(ReadScratchpad);
-    if (owmResult != OneWireMaster::Success)
-    {
-        return OneWireSlave::CommunicationError;
-    }
+    const uint8_t sendBlock[] = { ReadScratchpad };
     uint8_t recvBlock[13];
     const size_t recvBlockSize = sizeof(recvBlock) / sizeof(recvBlock[0]);
-    owmResult = master().OWReadBlock(recvBlock, recvBlockSize);
+    OneWireTransaction transaction;
+    transaction.writeBuf = sendBlock;
+    transaction.writeLen = sizeof(sendBlock) / sizeof(sendBlock[0]);
+    transaction.readBuf = recvBlock;
+    transaction.readLen = recvBlockSize;
+    owmResult = master().OWTransaction(transaction);
     if (owmResult != OneWireMaster::Success)
     {
         return OneWireSlave::CommunicationError;
@@ -177,6 +187,8 @@ OneWireSlave::CmdResult DS2431::readScratchpad(Scratchpad & data, uint8_t & esBy
 //*********************************************************************
 OneWireSlave::CmdResult DS2431::copyScratchpad(Address targetAddress, uint8_t esByte)
 {    
+    OneWireMaster::Lock busLock(master());
+    
     OneWireMaster::CmdResult owmResult = selectDevice();
     if(owmResult != OneWireMaster::Success)
     {
@@ -32,7 +32,9 @@
 
 
 #include "Slaves/Sensors/DS18B20/DS18B20.h"
+#include "Masters/OneWireTransaction.h"
 #include "wait_api.h"
+#include "us_ticker_api.h"
 
 
 using namespace OneWire;
@@ -51,7 +53,46 @@ enum DS18B20_CMDS
 
 
 /**********************************************************************/
-DS18B20::DS18B20(RandomAccessRomIterator &selector):OneWireSlave(selector)
+uint32_t DS18B20::conversionTimeUs(Resolution res)
+{
+    uint32_t timeUs;
+    
+    switch(res)
+    {
+        case DS18B20::NineBit:
+            timeUs = 93750;
+        break;
+        
+        case DS18B20::TenBit:
+            timeUs = 187500;
+        break;
+        
+        case DS18B20::ElevenBit:
+            timeUs = 375000;
+        break;
+        
+        case DS18B20::TwelveBit:
+        default:
+            timeUs = 750000;
+        break;
+    }
+    
+    return timeUs;
+}
+
+
+/// Maximum conversion time in ms for the given resolution, rounded up.
+static int conversionTimeMs(DS18B20::Resolution res)
+{
+    return ((DS18B20::conversionTimeUs(res) + 999) / 1000);
+}
+
+
+/**********************************************************************/
+DS18B20::DS18B20(RandomAccessRomIterator &selector)
+: OneWireSlave(selector), m_resolution(TwelveBit), m_th(0), m_tl(0), 
+  m_thresholdsValid(false), m_localPower(false), m_powerValid(false), 
+  m_conversionPending(false), m_conversionParasite(false), m_conversionStartUs(0)
 {
 }
 
@@ -59,6 +100,8 @@ DS18B20::DS18B20(RandomAccessRomIterator &selector):OneWireSlave(selector)
 /**********************************************************************/
 OneWireSlave::CmdResult DS18B20::writeScratchPad(uint8_t th, uint8_t tl, Resolution res)
 {
+    OneWireMaster::Lock busLock(master());
+    
     OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
     
     OneWireMaster::CmdResult owmResult = selectDevice();
@@ -70,6 +113,10 @@ OneWireSlave::CmdResult DS18B20::writeScratchPad(uint8_t th, uint8_t tl, Resolut
         owmResult = master().OWWriteBlock(sendBlock, 4);
         if (owmResult == OneWireMaster::Success)
         {
+            m_resolution = res;
+            m_th = th;
+            m_tl = tl;
+            m_thresholdsValid = true;
             deviceResult = OneWireSlave::Success;
         }
         else
@@ -85,28 +132,45 @@ OneWireSlave::CmdResult DS18B20::writeScratchPad(uint8_t th, uint8_t tl, Resolut
 /**********************************************************************/
 OneWireSlave::CmdResult DS18B20::readScratchPad(uint8_t * scratchPadBuff)
 {
+    OneWireMaster::Lock busLock(master());
+    
     OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
     
     OneWireMaster::CmdResult owmResult = selectDevice();
     
     if (owmResult == OneWireMaster::Success)
     {
-        owmResult = master().OWWriteByteSetLevel(READ_SCRATCHPAD, OneWireMaster::NormalLevel);
-        if (owmResult == OneWireMaster::Success)
+        const uint8_t txBlock[] = { READ_SCRATCHPAD };
+        uint8_t rxBlock[9];
+        
+        // Command and scratchpad read as one transaction
+        OneWireTransaction transaction;
+        transaction.writeBuf = txBlock;
+        transaction.writeLen = sizeof(txBlock);
+        transaction.readBuf = rxBlock;
+        transaction.readLen = sizeof(rxBlock);
+        owmResult = master().OWTransaction(transaction);
+        
+        uint8_t crcCheck = calculateCrc8(rxBlock, 8);
+        if ((owmResult == OneWireMaster::Success) && (crcCheck == rxBlock[8]))
         {
-            uint8_t rxBlock[9];
-            owmResult = master().OWReadBlock(rxBlock, 9);
-            
-            uint8_t crcCheck = calculateCrc8(rxBlock, 8);
-            if ((owmResult == OneWireMaster::Success) && (crcCheck == rxBlock[8]))
+            std::memcpy(scratchPadBuff, rxBlock, 8);
+            m_th = rxBlock[2];
+            m_tl = rxBlock[3];
+            m_thresholdsValid = true;
+            switch(rxBlock[4])
             {
-                std::memcpy(scratchPadBuff, rxBlock, 8);
-                deviceResult = OneWireSlave::Success;
-            }
-            else
-            {
-                deviceResult = OneWireSlave::CommunicationError;
+                case NineBit:
+                case TenBit:
+                case ElevenBit:
+                case TwelveBit:
+                    m_resolution = static_cast<Resolution>(rxBlock[4]);
+                break;
+                
+                default:
+                break;
             }
+            deviceResult = OneWireSlave::Success;
         }
         else
         {
@@ -121,6 +185,8 @@ OneWireSlave::CmdResult DS18B20::readScratchPad(uint8_t * scratchPadBuff)
 /**********************************************************************/
 OneWireSlave::CmdResult DS18B20::readPowerSupply(bool & localPower)
 {
+    OneWireMaster::Lock busLock(master());
+    
     OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
     
     OneWireMaster::CmdResult owmResult = selectDevice();
@@ -131,10 +197,12 @@ OneWireSlave::CmdResult DS18B20::readPowerSupply(bool & localPower)
         {
             uint8_t rtnBit = 0;
             
-            owmResult = master().OWTouchBitSetLevel(rtnBit, OneWireMaster::NormalLevel);
+            owmResult = master().OWReadBitSetLevel(rtnBit, OneWireMaster::NormalLevel);
             if(owmResult == OneWireMaster::Success)
             {
                 localPower = (rtnBit & 0x01);
+                m_localPower = localPower;
+                m_powerValid = true;
                 deviceResult = OneWireSlave::Success;
             }
             else
@@ -151,13 +219,72 @@ OneWireSlave::CmdResult DS18B20::readPowerSupply(bool & localPower)
     return deviceResult;
 }
 
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::refreshCapabilities( void )
+{
+    OneWireMaster::Lock busLock(master());
+    
+    bool localPower;
+    OneWireSlave::CmdResult deviceResult = this->readPowerSupply(localPower);
+    
+    if (deviceResult == OneWireSlave::Success)
+    {
+        uint8_t scratchPadBuff[8];
+        deviceResult = this->readScratchPad(scratchPadBuff);
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::readThresholds(uint8_t & th, uint8_t & tl)
+{
+    OneWireSlave::CmdResult deviceResult = OneWireSlave::Success;
+    
+    if (!m_thresholdsValid)
+    {
+        uint8_t scratchPadBuff[8];
+        deviceResult = this->readScratchPad(scratchPadBuff);
+    }
+    
+    if (deviceResult == OneWireSlave::Success)
+    {
+        th = m_th;
+        tl = m_tl;
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::cachedPowerSupply(bool & localPower)
+{
+    OneWireSlave::CmdResult deviceResult = OneWireSlave::Success;
+    
+    if (m_powerValid)
+    {
+        localPower = m_localPower;
+    }
+    else
+    {
+        deviceResult = this->readPowerSupply(localPower);
+    }
+    
+    return deviceResult;
+}
+
+
 /**********************************************************************/
 OneWireSlave::CmdResult DS18B20::copyScratchPad( void )
 {
+    OneWireMaster::Lock busLock(master());
+    
     OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
     
     bool hasLocalPower = false;
-    deviceResult = this->readPowerSupply(hasLocalPower);
+    deviceResult = cachedPowerSupply(hasLocalPower);
     
     if(deviceResult == OneWireSlave::Success)
     {
@@ -173,7 +300,7 @@ OneWireSlave::CmdResult DS18B20::copyScratchPad( void )
                     uint8_t recvbit = 0;
                     do
                     {
-                        owmResult = master().OWTouchBitSetLevel(recvbit, OneWireMaster::NormalLevel);
+                        owmResult = master().OWReadBitSetLevel(recvbit, OneWireMaster::NormalLevel);
                     }
                     while((!recvbit) && (owmResult == OneWireMaster::Success));
                     
@@ -224,12 +351,14 @@ OneWireSlave::CmdResult DS18B20::copyScratchPad( void )
 }
 
 /**********************************************************************/
-OneWireSlave::CmdResult DS18B20::convertTemperature(float & temp)
+OneWireSlave::CmdResult DS18B20::convertTemperature(int16_t & temp)
 {
+    OneWireMaster::Lock busLock(master());
+    
     OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
     
     bool hasLocalPower = false;
-    deviceResult = this->readPowerSupply(hasLocalPower);
+    deviceResult = cachedPowerSupply(hasLocalPower);
     
     uint8_t scratchPadBuff[8];
     
@@ -246,7 +375,7 @@ OneWireSlave::CmdResult DS18B20::convertTemperature(float & temp)
                     uint8_t recvbit = 0;
                     do
                     {
-                        owmResult = master().OWTouchBitSetLevel(recvbit, OneWireMaster::NormalLevel);
+                        owmResult = master().OWReadBitSetLevel(recvbit, OneWireMaster::NormalLevel);
                     }
                     while((owmResult == OneWireMaster::Success) && (!recvbit));
                     
@@ -269,7 +398,7 @@ OneWireSlave::CmdResult DS18B20::convertTemperature(float & temp)
                 owmResult = master().OWWriteByteSetLevel(CONV_TEMPERATURE, OneWireMaster::StrongLevel); 
                 if (owmResult == OneWireMaster::Success)
                 {
-                    wait_ms(750);
+                    wait_ms(conversionTimeMs(m_resolution));
                     
                     owmResult = master().OWSetLevel(OneWireMaster::NormalLevel);  
                     if (owmResult == OneWireMaster::Success)
@@ -295,29 +424,88 @@ OneWireSlave::CmdResult DS18B20::convertTemperature(float & temp)
     
     if(deviceResult == OneWireSlave::Success)
     {
-        int16_t intTemp = ((scratchPadBuff[1] << 8) | scratchPadBuff[0]);
-        
-        switch(scratchPadBuff[4])
+        deviceResult = decodeTemperature(scratchPadBuff, temp);
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::convertTemperature(float & temp)
+{
+    int16_t intTemp;
+    
+    OneWireSlave::CmdResult deviceResult = this->convertTemperature(intTemp);
+    if(deviceResult == OneWireSlave::Success)
+    {
+        temp = (intTemp * 0.0625F);
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::startConversion( void )
+{
+    OneWireMaster::Lock busLock(master());
+    
+    OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
+    
+    bool hasLocalPower = false;
+    deviceResult = cachedPowerSupply(hasLocalPower);
+    
+    if (deviceResult == OneWireSlave::Success)
+    {
+        OneWireMaster::CmdResult owmResult = selectDevice();
+        if(owmResult == OneWireMaster::Success)
         {
-            case DS18B20::NineBit:
-                temp = (intTemp * 0.5F);
-            break;
-            
-            case DS18B20::TenBit:
-                temp = (intTemp * 0.25F);
-            break;
-            
-            case DS18B20::ElevenBit:
-                temp = (intTemp * 0.125F);
-            break;
+            OneWireMaster::OWLevel afterLevel = hasLocalPower ? OneWireMaster::NormalLevel : OneWireMaster::StrongLevel;
             
-            case DS18B20::TwelveBit:
-                temp = (intTemp * 0.0625F);
-            break;
-            
-            default:
-                deviceResult = OneWireSlave::OperationFailure;
-            break;
+            owmResult = master().OWWriteByteSetLevel(CONV_TEMPERATURE, afterLevel);
+            if (owmResult == OneWireMaster::Success)
+            {
+                m_conversionPending = true;
+                m_conversionParasite = !hasLocalPower;
+                m_conversionStartUs = us_ticker_read();
+                if (m_conversionParasite)
+                {
+                    //Keep the bus until isConversionDone() releases the strong pullup
+                    master().lock();
+                }
+                deviceResult = OneWireSlave::Success;
+            }
+            else
+            {
+                deviceResult = OneWireSlave::CommunicationError;
+            }
+        }
+        else
+        {
+            deviceResult = OneWireSlave::OperationFailure;
+        }
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::isConversionDone(bool & done)
+{
+    OneWireMaster::Lock busLock(master());
+    
+    OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
+    
+    if (m_conversionPending)
+    {
+        deviceResult = OneWireSlave::Success;
+        done = ((us_ticker_read() - m_conversionStartUs) >= conversionTimeUs(m_resolution));
+        
+        if (done)
+        {
+            deviceResult = endConversion();
         }
     }
     
@@ -325,9 +513,215 @@ OneWireSlave::CmdResult DS18B20::convertTemperature(float & temp)
 }
 
 
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::endConversion( void )
+{
+    OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
+    
+    if (m_conversionPending)
+    {
+        deviceResult = OneWireSlave::Success;
+        m_conversionPending = false;
+        
+        if (m_conversionParasite)
+        {
+            OneWireMaster::CmdResult owmResult = master().OWSetLevel(OneWireMaster::NormalLevel);
+            if (owmResult != OneWireMaster::Success)
+            {
+                deviceResult = OneWireSlave::CommunicationError;
+            }
+            master().unlock();
+        }
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::readTemperature(int16_t & temp)
+{
+    uint8_t scratchPadBuff[8];
+    
+    OneWireSlave::CmdResult deviceResult = this->readScratchPad(scratchPadBuff);
+    if(deviceResult == OneWireSlave::Success)
+    {
+        deviceResult = decodeTemperature(scratchPadBuff, temp);
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::readTemperature(float & temp)
+{
+    int16_t intTemp;
+    
+    OneWireSlave::CmdResult deviceResult = this->readTemperature(intTemp);
+    if(deviceResult == OneWireSlave::Success)
+    {
+        temp = (intTemp * 0.0625F);
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::convertTemperatureAll(RandomAccessRomIterator & selector, Resolution slowestRes)
+{
+    OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
+    OneWireMaster & owm = selector.master();
+    OneWireMaster::Lock busLock(owm);
+    
+    bool allLocalPower = false;
+    OneWireMaster::CmdResult owmResult = readPowerSupplyAll(selector, allLocalPower);
+    
+    if(owmResult == OneWireMaster::Success)
+    {
+        deviceResult = convertTemperatureAll(selector, slowestRes, allLocalPower);
+    }
+    else
+    {
+        deviceResult = OneWireSlave::CommunicationError;
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::convertTemperatureAll(RandomAccessRomIterator & selector, Resolution slowestRes, bool allLocalPower)
+{
+    OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
+    OneWireMaster & owm = selector.master();
+    OneWireMaster::Lock busLock(owm);
+    
+    OneWireMaster::CmdResult owmResult = selector.selectAllDevices();
+    
+    if(owmResult == OneWireMaster::Success)
+    {
+        if(allLocalPower)
+        {
+            owmResult = owm.OWWriteByteSetLevel(CONV_TEMPERATURE, OneWireMaster::NormalLevel); 
+            if (owmResult == OneWireMaster::Success)
+            {
+                //Read slots stay low until the last device has finished
+                uint8_t recvbit = 0;
+                do
+                {
+                    owmResult = owm.OWReadBitSetLevel(recvbit, OneWireMaster::NormalLevel);
+                }
+                while((owmResult == OneWireMaster::Success) && (!recvbit));
+                
+                if((owmResult == OneWireMaster::Success) && (recvbit & 1))
+                {
+                    deviceResult = OneWireSlave::Success;
+                }
+                else
+                {
+                    deviceResult = OneWireSlave::TimeoutError;
+                }
+            }
+            else
+            {
+                deviceResult = OneWireSlave::CommunicationError;
+            }
+        }
+        else
+        {
+            owmResult = owm.OWWriteByteSetLevel(CONV_TEMPERATURE, OneWireMaster::StrongLevel); 
+            if (owmResult == OneWireMaster::Success)
+            {
+                wait_ms(conversionTimeMs(slowestRes));
+                
+                owmResult = owm.OWSetLevel(OneWireMaster::NormalLevel);  
+                if (owmResult == OneWireMaster::Success)
+                {
+                    deviceResult = OneWireSlave::Success;
+                }
+                else
+                {
+                    deviceResult = OneWireSlave::CommunicationError;
+                }
+            }
+            else
+            {
+                deviceResult = OneWireSlave::CommunicationError;
+            }
+        }
+    }
+    else
+    {
+        deviceResult = OneWireSlave::CommunicationError;
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::startConversionAll(RandomAccessRomIterator & selector)
+{
+    OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
+    OneWireMaster & owm = selector.master();
+    OneWireMaster::Lock busLock(owm);
+    
+    bool allLocalPower = false;
+    OneWireMaster::CmdResult owmResult = readPowerSupplyAll(selector, allLocalPower);
+    
+    if((owmResult == OneWireMaster::Success) && allLocalPower)
+    {
+        owmResult = selector.selectAllDevices();
+        if(owmResult == OneWireMaster::Success)
+        {
+            owmResult = owm.OWWriteByteSetLevel(CONV_TEMPERATURE, OneWireMaster::NormalLevel);
+        }
+        
+        if(owmResult == OneWireMaster::Success)
+        {
+            deviceResult = OneWireSlave::Success;
+        }
+    }
+    
+    if(owmResult != OneWireMaster::Success)
+    {
+        deviceResult = OneWireSlave::CommunicationError;
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+OneWireMaster::CmdResult DS18B20::readPowerSupplyAll(RandomAccessRomIterator & selector, bool & allLocalPower)
+{
+    OneWireMaster & owm = selector.master();
+    
+    //Any parasite powered device pulls the read slot low
+    allLocalPower = false;
+    OneWireMaster::CmdResult owmResult = selector.selectAllDevices();
+    if(owmResult == OneWireMaster::Success)
+    {
+        owmResult = owm.OWWriteByteSetLevel(READ_POWER_SUPPY, OneWireMaster::NormalLevel);
+        if(owmResult == OneWireMaster::Success)
+        {
+            uint8_t rtnBit = 0;
+            owmResult = owm.OWReadBitSetLevel(rtnBit, OneWireMaster::NormalLevel);
+            allLocalPower = (rtnBit & 0x01);
+        }
+    }
+    
+    return owmResult;
+}
+
+
 /**********************************************************************/
 OneWireSlave::CmdResult DS18B20::recallEEPROM( void )
 {
+    OneWireMaster::Lock busLock(master());
+    
     OneWireSlave::CmdResult deviceResult = OneWireSlave::OperationFailure;
     
     OneWireMaster::CmdResult owmResult = selectDevice();
@@ -339,6 +733,9 @@ OneWireSlave::CmdResult DS18B20::recallEEPROM( void )
         owmResult = master().OWWriteBlock(&cmd, 1);
         if (owmResult == OneWireMaster::Success)
         {
+            //EEPROM contents are unknown, assume the slowest conversion
+            m_resolution = TwelveBit;
+            m_thresholdsValid = false;
             deviceResult = OneWireSlave::Success;
         }
         else
@@ -349,3 +746,43 @@ OneWireSlave::CmdResult DS18B20::recallEEPROM( void )
     
     return deviceResult;
 }
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult DS18B20::decodeTemperature(const uint8_t * scratchPadBuff, int16_t & temp)
+{
+    OneWireSlave::CmdResult deviceResult = OneWireSlave::Success;
+    
+    //The temperature register is always in 1/16 degree units, lower
+    //resolutions leave the least significant bits undefined
+    int16_t intTemp = ((scratchPadBuff[1] << 8) | scratchPadBuff[0]);
+    
+    switch(scratchPadBuff[4])
+    {
+        case DS18B20::NineBit:
+            intTemp &= ~0x0007;
+        break;
+        
+        case DS18B20::TenBit:
+            intTemp &= ~0x0003;
+        break;
+        
+        case DS18B20::ElevenBit:
+            intTemp &= ~0x0001;
+        break;
+        
+        case DS18B20::TwelveBit:
+        break;
+        
+        default:
+            deviceResult = OneWireSlave::OperationFailure;
+        break;
+    }
+    
+    if(deviceResult == OneWireSlave::Success)
+    {
+        temp = intTemp;
+    }
+    
+    return deviceResult;
+}
@@ -84,6 +84,52 @@ namespace OneWire
         DS18B20(RandomAccessRomIterator &selector);
         
         
+        ///Last known resolution, updated by writeScratchPad and 
+        ///readScratchPad, power-on default is TwelveBit
+        Resolution resolution() const { return m_resolution; }
+        
+        ///Maximum conversion time in us at the given resolution
+        static uint32_t conversionTimeUs(Resolution res);
+        
+        
+        /**********************************************************//**
+        * @brief Refresh Capabilities
+        *
+        * @details Re-reads the power mode, resolution and alarm 
+        * thresholds from the device into the per-instance cache. The 
+        * cache is otherwise filled lazily by the first command that 
+        * needs it, use this after the device has been replaced or its
+        * power wiring changed.
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out]
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        OneWireSlave::CmdResult refreshCapabilities( void );
+        
+        
+        /**********************************************************//**
+        * @brief Read Thresholds
+        *
+        * @details Returns the TH and TL alarm thresholds from the 
+        * cache, reading the scratchpad only if they are not known.
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out] th - 8-bit upper temperature threshold
+        * @param[out] tl - 8-bit lower temperature threshold
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        OneWireSlave::CmdResult readThresholds(uint8_t & th, uint8_t & tl);
+        
+        
         /**********************************************************//**
         * @brief Write Scratchpad Command
         *
@@ -146,7 +192,8 @@ namespace OneWire
         * @brief Read Power Supply command
         *
         * @details This command determines if the DS18B20 is parasite
-        * powered or has a local supply
+        * powered or has a local supply. The bus is always accessed and
+        * the result is cached for later conversions.
         *
         * On Entry:
         * @param[in] 
@@ -176,6 +223,197 @@ namespace OneWire
         OneWireSlave::CmdResult convertTemperature(float & temp);
         
         
+        /**********************************************************//**
+        * @brief Convert Temperature Command
+        *
+        * @details Fixed-point variant of convertTemperature() that 
+        * does not use floating point.
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out] temp - temperature in 1/16 degree Celsius units
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        OneWireSlave::CmdResult convertTemperature(int16_t & temp);
+
+
+        /**********************************************************//**
+        * @brief Start Conversion
+        *
+        * @details Begins a temperature conversion and returns
+        * immediately. A parasite powered device is left on the strong
+        * pullup, so no other traffic may be placed on this bus until
+        * isConversionDone() reports completion. The bus lock is held
+        * by the calling thread for that time. The result is read
+        * with readTemperature().
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out]
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        OneWireSlave::CmdResult startConversion( void );
+
+
+        /**********************************************************//**
+        * @brief Is Conversion Done
+        *
+        * @details Checks the conversion started by startConversion()
+        * against the maximum conversion time of the cached resolution
+        * (93.75/187.5/375/750 ms). The bus is not accessed until the 
+        * time has elapsed, at which point the strong pullup of a 
+        * parasite powered device is released.
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out] done - True once the conversion has completed
+        *
+        * @return CmdResult - result of operation, OperationFailure if
+        * no conversion was started
+        **************************************************************/
+        OneWireSlave::CmdResult isConversionDone(bool & done);
+
+
+        /**********************************************************//**
+        * @brief End Conversion
+        *
+        * @details Ends the conversion started by startConversion()
+        * without checking the conversion time, releasing the strong
+        * pullup and bus lock of a parasite powered device. For 
+        * callers that time the conversion themselves.
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out]
+        *
+        * @return CmdResult - result of operation, OperationFailure if
+        * no conversion was started
+        **************************************************************/
+        OneWireSlave::CmdResult endConversion( void );
+        
+        
+        ///True while a conversion started by startConversion() holds
+        ///the strong pullup of a parasite powered device
+        bool conversionHoldsBus() const { return (m_conversionPending && m_conversionParasite); }
+
+
+        /**********************************************************//**
+        * @brief Read Temperature
+        *
+        * @details Reads the result of the last temperature conversion
+        * from the scratchpad without starting a new conversion. Use
+        * after convertTemperatureAll() to collect the result of each
+        * device on the bus.
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out] temp - temperature in degrees Celsius
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        OneWireSlave::CmdResult readTemperature(float & temp);
+        
+        
+        /**********************************************************//**
+        * @brief Read Temperature
+        *
+        * @details Fixed-point variant of readTemperature() that does
+        * not use floating point.
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out] temp - temperature in 1/16 degree Celsius units
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        OneWireSlave::CmdResult readTemperature(int16_t & temp);
+
+
+        /**********************************************************//**
+        * @brief Convert Temperature Command for all devices
+        *
+        * @details Issues a single Skip ROM + Convert T so that every
+        * DS18B20 on the bus converts at the same time. If any device
+        * on the bus is parasite powered, the strong pullup is held for
+        * the conversion time of the slowest resolution, otherwise the
+        * bus is polled until the last device has finished. Results are
+        * then read from each device with readTemperature().
+        *
+        * On Entry:
+        * @param[in] selector - Reference to RandomAccessRomIterator
+        * object that encapsulates owm master that has access to the
+        * devices
+        * @param[in] slowestRes - Highest resolution configured on any
+        * device on the bus
+        *
+        * On Exit:
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        static OneWireSlave::CmdResult convertTemperatureAll(RandomAccessRomIterator & selector, Resolution slowestRes = TwelveBit);
+
+
+        /**********************************************************//**
+        * @brief Convert Temperature Command for all devices with a 
+        * known power mode
+        *
+        * @details Same as convertTemperatureAll() but skips the Read
+        * Power Supply when the caller has already determined it, for
+        * example from startConversionAll() returning OperationFailure.
+        *
+        * On Entry:
+        * @param[in] selector - Reference to RandomAccessRomIterator
+        * object that encapsulates owm master that has access to the
+        * devices
+        * @param[in] slowestRes - Highest resolution configured on any
+        * device on the bus
+        * @param[in] allLocalPower - True if every device on the bus
+        * is locally powered
+        *
+        * On Exit:
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        static OneWireSlave::CmdResult convertTemperatureAll(RandomAccessRomIterator & selector, Resolution slowestRes, bool allLocalPower);
+
+
+        /**********************************************************//**
+        * @brief Start Conversion for all devices
+        *
+        * @details Issues a single Skip ROM + Convert T and returns
+        * immediately so that other buses can be served while the
+        * devices convert. Only a bus where every device is locally 
+        * powered can be left this way, otherwise nothing is started.
+        * Results are read with readTemperature() once the conversion 
+        * time of the slowest resolution has elapsed.
+        *
+        * On Entry:
+        * @param[in] selector - Reference to RandomAccessRomIterator
+        * object that encapsulates owm master that has access to the
+        * devices
+        *
+        * On Exit:
+        *
+        * @return CmdResult - result of operation, OperationFailure if
+        * any device on the bus is parasite powered
+        **************************************************************/
+        static OneWireSlave::CmdResult startConversionAll(RandomAccessRomIterator & selector);
+
+
         /**********************************************************//**
         * @brief Recall Command
         *
@@ -192,6 +430,27 @@ namespace OneWire
         **************************************************************/
         OneWireSlave::CmdResult recallEEPROM( void );
 
+    private:
+
+        Resolution m_resolution;
+        uint8_t m_th;
+        uint8_t m_tl;
+        bool m_thresholdsValid;
+        bool m_localPower;
+        bool m_powerValid;
+        bool m_conversionPending;
+        bool m_conversionParasite;
+        uint32_t m_conversionStartUs;
+
+        /// Power mode from the cache, reading it from the device if unknown.
+        OneWireSlave::CmdResult cachedPowerSupply(bool & localPower);
+        
+        /// Broadcast Read Power Supply, any parasite powered device pulls the read slot low.
+        static OneWireMaster::CmdResult readPowerSupplyAll(RandomAccessRomIterator & selector, bool & allLocalPower);
+        
+        /// Decode the temperature register from scratchpad bytes 0, 1 and 4.
+        static OneWireSlave::CmdResult decodeTemperature(const uint8_t * scratchPadBuff, int16_t & temp);
+
     };
 }
 
@@ -58,6 +58,8 @@ DS1920::DS1920(RandomAccessRomIterator &selector):OneWireSlave(selector)
 /**********************************************************************/
 DS1920::CmdResult DS1920::writeScratchPad(uint8_t th, uint8_t tl)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS1920::CmdResult deviceResult = DS1920::OpFailure;
     
     OneWireMaster::CmdResult owmResult = selectDevice();
@@ -84,6 +86,8 @@ DS1920::CmdResult DS1920::writeScratchPad(uint8_t th, uint8_t tl)
 /**********************************************************************/
 DS1920::CmdResult DS1920::readScratchPad(uint8_t * scratchPadBuff)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS1920::CmdResult deviceResult = DS1920::OpFailure;
     
     OneWireMaster::CmdResult owmResult = selectDevice();
@@ -121,6 +125,8 @@ DS1920::CmdResult DS1920::readScratchPad(uint8_t * scratchPadBuff)
 /**********************************************************************/
 DS1920::CmdResult DS1920::copyScratchPad( void )
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS1920::CmdResult deviceResult = DS1920::OpFailure;
     
     OneWireMaster::CmdResult owmResult = selectDevice();
@@ -148,8 +154,10 @@ DS1920::CmdResult DS1920::copyScratchPad( void )
 }
 
 /**********************************************************************/
-DS1920::CmdResult DS1920::convertTemperature(float & temp)
+DS1920::CmdResult DS1920::convertTemperature(int16_t & temp)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS1920::CmdResult deviceResult = DS1920::OpFailure;
     
     OneWireMaster::CmdResult owmResult = selectDevice();
@@ -168,19 +176,7 @@ DS1920::CmdResult DS1920::convertTemperature(float & temp)
                 deviceResult = this->readScratchPad(scratchPadBuff);
                 if(deviceResult == DS1920::Success)
                 {
-                    if(scratchPadBuff[0] & 1)
-                    {
-                        temp = (((float) (scratchPadBuff[0] >> 1)) + 0.5F);
-                    }
-                    else
-                    {
-                        temp = ((float) (scratchPadBuff[0] >> 1));
-                    }
-                    
-                    if(scratchPadBuff[1])
-                    {
-                        temp = (temp * -1.0F);
-                    }
+                    temp = decodeTemperature(scratchPadBuff);
                 }
             }
         }
@@ -194,9 +190,50 @@ DS1920::CmdResult DS1920::convertTemperature(float & temp)
 }
 
 
+/**********************************************************************/
+DS1920::CmdResult DS1920::convertTemperature(float & temp)
+{
+    int16_t intTemp;
+    
+    DS1920::CmdResult deviceResult = this->convertTemperature(intTemp);
+    if(deviceResult == DS1920::Success)
+    {
+        temp = (intTemp * 0.0625F);
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+DS1920::CmdResult DS1920::readTemperature(int16_t & temp)
+{
+    uint8_t scratchPadBuff[8];
+    
+    DS1920::CmdResult deviceResult = this->readScratchPad(scratchPadBuff);
+    if(deviceResult == DS1920::Success)
+    {
+        temp = decodeTemperature(scratchPadBuff);
+    }
+    
+    return deviceResult;
+}
+
+
+/**********************************************************************/
+int16_t DS1920::decodeTemperature(const uint8_t * scratchPadBuff)
+{
+    //Two's complement in 1/2 degree units, MSB is sign extension
+    int16_t halfDegrees = static_cast<int16_t>((scratchPadBuff[1] << 8) | scratchPadBuff[0]);
+    return static_cast<int16_t>(halfDegrees * 8);
+}
+
+
 /**********************************************************************/
 DS1920::CmdResult DS1920::recallEEPROM( void )
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS1920::CmdResult deviceResult = DS1920::OpFailure;
     
     OneWireMaster::CmdResult owmResult = selectDevice();
@@ -157,6 +157,40 @@ namespace OneWire
         CmdResult convertTemperature(float & temp);
         
         
+        /**********************************************************//**
+        * @brief Convert Temperature Command
+        *
+        * @details Fixed-point variant of convertTemperature() that 
+        * does not use floating point.
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out] temp - temperature in 1/16 degree Celsius units
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        CmdResult convertTemperature(int16_t & temp);
+        
+        
+        /**********************************************************//**
+        * @brief Read Temperature
+        *
+        * @details Reads the result of the last temperature conversion
+        * from the scratchpad without starting a new conversion.
+        *
+        * On Entry:
+        * @param[in]
+        *
+        * On Exit:
+        * @param[out] temp - temperature in 1/16 degree Celsius units
+        *
+        * @return CmdResult - result of operation
+        **************************************************************/
+        CmdResult readTemperature(int16_t & temp);
+        
+        
         /**********************************************************//**
         * @brief Recall Command
         *
@@ -175,6 +209,9 @@ namespace OneWire
         
     private:
 
+        /// Decode the temperature from scratchpad bytes 0 and 1.
+        static int16_t decodeTemperature(const uint8_t * scratchPadBuff);
+
     };
 }
 
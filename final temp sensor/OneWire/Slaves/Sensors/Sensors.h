@@ -36,5 +36,6 @@
 
 #include "Slaves/Sensors/DS1920/DS1920.h"
 #include "Slaves/Sensors/DS18B20/DS18B20.h"
+#include "Slaves/Sensors/TemperatureSampler/TemperatureSampler.h"
 
 #endif /*ONEWIRE_SENSORS_H*/
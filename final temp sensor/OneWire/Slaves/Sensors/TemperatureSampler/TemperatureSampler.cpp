@@ -0,0 +1,385 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+
+#include "Slaves/Sensors/TemperatureSampler/TemperatureSampler.h"
+
+
+using namespace OneWire;
+
+
+enum TemperatureSampler_CMDS
+{
+    CONV_TEMPERATURE = 0x44
+};
+
+
+/// DS1920 maximum conversion time in ms.
+static const uint32_t DS1920_CONVERSION_TIME_MS = 750;
+
+
+/// True once nowMs has reached targetMs, tolerates timer wrap.
+static bool timeReached(uint32_t nowMs, uint32_t targetMs)
+{
+    return (static_cast<int32_t>(nowMs - targetMs) >= 0);
+}
+
+
+/// Map a DS1920 result onto the common slave result.
+static OneWireSlave::CmdResult toSlaveResult(DS1920::CmdResult result)
+{
+    OneWireSlave::CmdResult slaveResult;
+    
+    switch(result)
+    {
+        case DS1920::Success:
+            slaveResult = OneWireSlave::Success;
+        break;
+        
+        case DS1920::CommsReadError:
+        case DS1920::CommsWriteError:
+            slaveResult = OneWireSlave::CommunicationError;
+        break;
+        
+        case DS1920::OpFailure:
+        default:
+            slaveResult = OneWireSlave::OperationFailure;
+        break;
+    }
+    
+    return slaveResult;
+}
+
+
+/**********************************************************************/
+TemperatureSampler::TemperatureSampler(RandomAccessRomIterator & selector)
+: m_selector(selector), m_numEntries(0), m_droppedSamples(0), m_mergeWindowMs(0),
+  m_slotActive(false), m_slotParasite(false), m_slotSensor(NULL), m_slotStartMs(0), m_slotWaitMs(0)
+{
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult TemperatureSampler::addSensor(DS18B20 & sensor, uint32_t periodMs, DS18B20::Resolution res)
+{
+    OneWireSlave::CmdResult result = OneWireSlave::OperationFailure;
+    
+    if (m_numEntries < maxSensors)
+    {
+        bool localPower = false;
+        result = sensor.readPowerSupply(localPower);
+        
+        if (result == OneWireSlave::Success)
+        {
+            uint8_t th, tl;
+            result = sensor.readThresholds(th, tl);
+            if ((result == OneWireSlave::Success) && (sensor.resolution() != res))
+            {
+                result = sensor.writeScratchPad(th, tl, res);
+            }
+        }
+        
+        if (result == OneWireSlave::Success)
+        {
+            Entry entry;
+            entry.ds18b20 = &sensor;
+            entry.ds1920 = NULL;
+            entry.periodMs = periodMs;
+            entry.nextDueMs = 0;
+            entry.conversionTimeMs = ((DS18B20::conversionTimeUs(res) + 999) / 1000);
+            entry.localPower = localPower;
+            entry.scheduled = false;
+            entry.inSlot = false;
+            result = addEntry(entry);
+        }
+    }
+    
+    return result;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult TemperatureSampler::addSensor(DS1920 & sensor, uint32_t periodMs)
+{
+    Entry entry;
+    entry.ds18b20 = NULL;
+    entry.ds1920 = &sensor;
+    entry.periodMs = periodMs;
+    entry.nextDueMs = 0;
+    entry.conversionTimeMs = DS1920_CONVERSION_TIME_MS;
+    entry.localPower = false;
+    entry.scheduled = false;
+    entry.inSlot = false;
+    
+    return addEntry(entry);
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult TemperatureSampler::addEntry(const Entry & entry)
+{
+    OneWireSlave::CmdResult result = OneWireSlave::OperationFailure;
+    
+    if (m_numEntries < maxSensors)
+    {
+        m_entries[m_numEntries++] = entry;
+        result = OneWireSlave::Success;
+    }
+    
+    return result;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult TemperatureSampler::poll(uint32_t nowMs)
+{
+    OneWireSlave::CmdResult result = OneWireSlave::Success;
+    
+    if (m_slotActive)
+    {
+        result = finishSlot(nowMs);
+    }
+    
+    if (!m_slotActive && (result == OneWireSlave::Success))
+    {
+        result = startSlot(nowMs);
+    }
+    
+    return result;
+}
+
+
+/**********************************************************************/
+uint32_t TemperatureSampler::msUntilNextPoll(uint32_t nowMs) const
+{
+    uint32_t waitMs = 0xFFFFFFFF;
+    
+    if (m_slotActive)
+    {
+        uint32_t endMs = (m_slotStartMs + m_slotWaitMs);
+        waitMs = timeReached(nowMs, endMs) ? 0 : (endMs - nowMs);
+    }
+    else
+    {
+        for (size_t idx = 0; idx < m_numEntries; idx++)
+        {
+            const Entry & entry = m_entries[idx];
+            uint32_t entryWaitMs = 0;
+            
+            if (entry.scheduled && !timeReached(nowMs + m_mergeWindowMs, entry.nextDueMs))
+            {
+                entryWaitMs = (entry.nextDueMs - (nowMs + m_mergeWindowMs));
+            }
+            
+            if (entryWaitMs < waitMs)
+            {
+                waitMs = entryWaitMs;
+            }
+        }
+    }
+    
+    return waitMs;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult TemperatureSampler::startSlot(uint32_t nowMs)
+{
+    OneWireSlave::CmdResult result = OneWireSlave::Success;
+    
+    size_t numDue = 0;
+    Entry * lastDue = NULL;
+    for (size_t idx = 0; idx < m_numEntries; idx++)
+    {
+        Entry & entry = m_entries[idx];
+        entry.inSlot = (!entry.scheduled || timeReached(nowMs + m_mergeWindowMs, entry.nextDueMs));
+        if (entry.inSlot)
+        {
+            numDue++;
+            lastDue = &entry;
+        }
+    }
+    
+    if (numDue == 0)
+    {
+        return result;
+    }
+    
+    m_slotStartMs = nowMs;
+    
+    if ((numDue == 1) && (lastDue->ds18b20 != NULL))
+    {
+        //Only this device converts, so only its own time is waited
+        result = lastDue->ds18b20->startConversion();
+        m_slotSensor = lastDue->ds18b20;
+        m_slotParasite = !lastDue->localPower;
+        m_slotWaitMs = lastDue->conversionTimeMs;
+    }
+    else
+    {
+        //Every device on the bus converts, a parasite powered device 
+        //anywhere holds the strong pullup for the slowest conversion
+        m_slotSensor = NULL;
+        m_slotParasite = false;
+        for (size_t idx = 0; idx < m_numEntries; idx++)
+        {
+            m_slotParasite = (m_slotParasite || !m_entries[idx].localPower);
+        }
+        
+        m_slotWaitMs = 0;
+        for (size_t idx = 0; idx < m_numEntries; idx++)
+        {
+            const Entry & entry = m_entries[idx];
+            if ((entry.inSlot || m_slotParasite) && (entry.conversionTimeMs > m_slotWaitMs))
+            {
+                m_slotWaitMs = entry.conversionTimeMs;
+            }
+        }
+        
+        OneWireMaster & owm = m_selector.master();
+        OneWireMaster::Lock busLock(owm);
+        
+        OneWireMaster::CmdResult owmResult = m_selector.selectAllDevices();
+        if (owmResult == OneWireMaster::Success)
+        {
+            owmResult = owm.OWWriteByteSetLevel(CONV_TEMPERATURE, m_slotParasite ? OneWireMaster::StrongLevel : OneWireMaster::NormalLevel);
+        }
+        
+        if ((owmResult == OneWireMaster::Success) && m_slotParasite)
+        {
+            //Keep the bus until finishSlot() releases the strong pullup
+            owm.lock();
+        }
+        
+        if (owmResult != OneWireMaster::Success)
+        {
+            result = OneWireSlave::CommunicationError;
+        }
+    }
+    
+    if (result == OneWireSlave::Success)
+    {
+        m_slotActive = true;
+    }
+    else
+    {
+        //Report the failure and retry on the next period
+        for (size_t idx = 0; idx < m_numEntries; idx++)
+        {
+            if (m_entries[idx].inSlot)
+            {
+                completeEntry(m_entries[idx], 0, result);
+            }
+        }
+    }
+    
+    return result;
+}
+
+
+/**********************************************************************/
+OneWireSlave::CmdResult TemperatureSampler::finishSlot(uint32_t nowMs)
+{
+    OneWireSlave::CmdResult result = OneWireSlave::Success;
+    
+    if (!timeReached(nowMs, m_slotStartMs + m_slotWaitMs))
+    {
+        return result;
+    }
+    
+    m_slotActive = false;
+    
+    if (m_slotSensor != NULL)
+    {
+        result = m_slotSensor->endConversion();
+    }
+    else if (m_slotParasite)
+    {
+        OneWireMaster::CmdResult owmResult = m_selector.master().OWSetLevel(OneWireMaster::NormalLevel);
+        if (owmResult != OneWireMaster::Success)
+        {
+            result = OneWireSlave::CommunicationError;
+        }
+        m_selector.master().unlock();
+    }
+    
+    for (size_t idx = 0; idx < m_numEntries; idx++)
+    {
+        Entry & entry = m_entries[idx];
+        if (entry.inSlot)
+        {
+            int16_t temperature = 0;
+            OneWireSlave::CmdResult sensorResult = result;
+            
+            if (sensorResult == OneWireSlave::Success)
+            {
+                if (entry.ds18b20 != NULL)
+                {
+                    sensorResult = entry.ds18b20->readTemperature(temperature);
+                }
+                else
+                {
+                    sensorResult = toSlaveResult(entry.ds1920->readTemperature(temperature));
+                }
+            }
+            
+            completeEntry(entry, temperature, sensorResult);
+        }
+    }
+    
+    return result;
+}
+
+
+/**********************************************************************/
+void TemperatureSampler::completeEntry(Entry & entry, int16_t temperature, OneWireSlave::CmdResult result)
+{
+    Sample sample;
+    sample.romId = (entry.ds18b20 != NULL) ? entry.ds18b20->romId() : entry.ds1920->romId();
+    sample.timestampMs = m_slotStartMs;
+    sample.temperature = temperature;
+    sample.result = result;
+    
+    if (!m_samples.push_back_overwrite(sample))
+    {
+        m_droppedSamples++;
+    }
+    
+    //Keep the phase of sensors merged in early, restart late ones
+    entry.nextDueMs = (entry.scheduled ? entry.nextDueMs : m_slotStartMs) + entry.periodMs;
+    if (timeReached(m_slotStartMs, entry.nextDueMs))
+    {
+        entry.nextDueMs = (m_slotStartMs + entry.periodMs);
+    }
+    entry.scheduled = true;
+    entry.inSlot = false;
+}
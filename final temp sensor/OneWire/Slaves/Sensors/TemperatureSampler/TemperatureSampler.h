@@ -0,0 +1,221 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Slaves_Sensors_TemperatureSampler
+#define OneWire_Slaves_Sensors_TemperatureSampler
+
+#include "Slaves/Sensors/DS18B20/DS18B20.h"
+#include "Slaves/Sensors/DS1920/DS1920.h"
+#include "Utilities/array.h"
+#include "Utilities/ring_buffer.h"
+
+namespace OneWire
+{
+    /**
+    * @brief Multi-rate sampling engine for DS18B20 and DS1920 sensors
+    *
+    * @details Each registered sensor has its own sample period. Sensors
+    * that fall due within the merge window of each other share one 
+    * broadcast Skip ROM + Convert T slot, after which only the due 
+    * sensors are read. A slot with a single due DS18B20 is converted 
+    * by Match ROM instead so that only its own conversion time is 
+    * waited. Samples are timestamped with the start of their 
+    * conversion and stored in a fixed-capacity ring buffer, the oldest
+    * sample is dropped when the buffer is full.
+    *
+    * poll() never blocks for a conversion, call it periodically with 
+    * the current time in ms from any monotonic source.
+    *
+    * @code
+    * MultidropRomIterator selector(owm);
+    * DS18B20 probe(selector);
+    * probe.setRomId(romId);
+    * TemperatureSampler sampler(selector);
+    * sampler.addSensor(probe, 1000, DS18B20::TenBit);
+    * while (true)
+    * {
+    *     sampler.poll(nowMs());
+    *     TemperatureSampler::Sample sample;
+    *     while (sampler.readSample(sample)) { ... }
+    * }
+    * @endcode
+    */
+    class TemperatureSampler
+    {
+    public:
+        
+        static const size_t maxSensors = 16;
+        static const size_t sampleCapacity = 32;
+        
+        /// Temperature sample delivered by the sampler.
+        struct Sample
+        {
+            /// ROM ID of the sensor
+            RomId romId;
+            /// Time the conversion was started, in ms
+            uint32_t timestampMs;
+            /// Temperature in 1/16 degree Celsius units
+            int16_t temperature;
+            /// Result of reading the sensor, temperature is only valid on Success
+            OneWireSlave::CmdResult result;
+        };
+        
+        /**********************************************************//**
+        * @brief TemperatureSampler constructor
+        *
+        * @details
+        *
+        * On Entry:
+        * @param[in] selector - Reference to RandomAccessRomIterator 
+        * shared by all registered sensors, used for broadcast 
+        * conversions
+        *
+        * On Exit:
+        *
+        * @return
+        **************************************************************/
+        TemperatureSampler(RandomAccessRomIterator & selector);
+        
+        
+        /**********************************************************//**
+        * @brief Add DS18B20
+        *
+        * @details Registers a DS18B20, reads its power mode and writes 
+        * the requested resolution if it differs from the device. The 
+        * first sample is due on the next poll.
+        *
+        * On Entry:
+        * @param[in] sensor - sensor with its ROM ID set, must outlive
+        * the sampler
+        * @param[in] periodMs - sample period in ms
+        * @param[in] res - resolution to sample at
+        *
+        * On Exit:
+        *
+        * @return CmdResult - result of operation, OperationFailure if
+        * maxSensors are already registered
+        **************************************************************/
+        OneWireSlave::CmdResult addSensor(DS18B20 & sensor, uint32_t periodMs, DS18B20::Resolution res = DS18B20::TwelveBit);
+        
+        
+        /**********************************************************//**
+        * @brief Add DS1920
+        *
+        * @details Registers a DS1920. The DS1920 is parasite powered 
+        * and always converts in 750 ms.
+        *
+        * On Entry:
+        * @param[in] sensor - sensor with its ROM ID set, must outlive
+        * the sampler
+        * @param[in] periodMs - sample period in ms
+        *
+        * On Exit:
+        *
+        * @return CmdResult - result of operation, OperationFailure if
+        * maxSensors are already registered
+        **************************************************************/
+        OneWireSlave::CmdResult addSensor(DS1920 & sensor, uint32_t periodMs);
+        
+        
+        ///Sensors due within this many ms of the first due sensor share
+        ///its conversion slot, default is 0
+        void setMergeWindow(uint32_t windowMs) { m_mergeWindowMs = windowMs; }
+        
+        
+        /**********************************************************//**
+        * @brief Poll
+        *
+        * @details Advances the sampler. Starts a conversion slot when 
+        * sensors are due, or reads the sensors of the running slot 
+        * once its conversion time has elapsed. Errors from individual
+        * sensors are reported in their samples.
+        *
+        * On Entry:
+        * @param[in] nowMs - current time in ms
+        *
+        * On Exit:
+        *
+        * @return CmdResult - result of the bus level operations
+        **************************************************************/
+        OneWireSlave::CmdResult poll(uint32_t nowMs);
+        
+        
+        ///True while a conversion slot is running, the bus must not be 
+        ///used by others while a parasite conversion holds the pullup
+        bool busy() const { return m_slotActive; }
+        
+        ///Time in ms until poll() next has work to do
+        uint32_t msUntilNextPoll(uint32_t nowMs) const;
+        
+        ///Take the oldest sample, returns false if none are available
+        bool readSample(Sample & sample) { return m_samples.pop_front(sample); }
+        
+        ///Number of samples waiting to be read
+        size_t samplesAvailable() const { return m_samples.size(); }
+        
+        ///Number of samples dropped because the buffer was full
+        uint32_t droppedSamples() const { return m_droppedSamples; }
+        
+    private:
+        
+        struct Entry
+        {
+            DS18B20 * ds18b20;
+            DS1920 * ds1920;
+            uint32_t periodMs;
+            uint32_t nextDueMs;
+            uint32_t conversionTimeMs;
+            bool localPower;
+            bool scheduled;
+            bool inSlot;
+        };
+        
+        RandomAccessRomIterator & m_selector;
+        array<Entry, maxSensors> m_entries;
+        size_t m_numEntries;
+        ring_buffer<Sample, sampleCapacity> m_samples;
+        uint32_t m_droppedSamples;
+        uint32_t m_mergeWindowMs;
+        bool m_slotActive;
+        bool m_slotParasite;
+        DS18B20 * m_slotSensor;
+        uint32_t m_slotStartMs;
+        uint32_t m_slotWaitMs;
+        
+        OneWireSlave::CmdResult addEntry(const Entry & entry);
+        OneWireSlave::CmdResult startSlot(uint32_t nowMs);
+        OneWireSlave::CmdResult finishSlot(uint32_t nowMs);
+        void completeEntry(Entry & entry, int16_t temperature, OneWireSlave::CmdResult result);
+    };
+}
+
+#endif /* OneWire_Slaves_Sensors_TemperatureSampler */
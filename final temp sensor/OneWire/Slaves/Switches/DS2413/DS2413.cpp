@@ -129,6 +129,8 @@ DS2413::CmdResult DS2413::pioAccessWriteChAB(uint8_t val)
 
 DS2413::CmdResult DS2413::pioAccessRead(uint8_t & val)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS2413::CmdResult result = DS2413::OpFailure;
 
     OneWireMaster::CmdResult ow_result = selectDevice();
@@ -161,6 +163,8 @@ DS2413::CmdResult DS2413::pioAccessRead(uint8_t & val)
 
 DS2413::CmdResult DS2413::pioAccessWrite(uint8_t val)
 {
+    OneWireMaster::Lock busLock(master());
+    
     DS2413::CmdResult result = DS2413::OpFailure;
 
     OneWireMaster::CmdResult ow_result = selectDevice();
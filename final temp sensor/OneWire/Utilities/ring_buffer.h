@@ -0,0 +1,131 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_ring_buffer
+#define OneWire_ring_buffer
+
+#include <stddef.h>
+
+namespace OneWire
+{
+    /// Fixed-capacity FIFO ring buffer that does not allocate.
+    template <typename T, size_t N>
+    class ring_buffer
+    {
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef value_type & reference;
+        typedef const value_type & const_reference;
+        
+        ring_buffer() : _head(0), _count(0) { }
+        
+        // Element access
+        reference front() { return _buffer[_head]; }
+        const_reference front() const { return _buffer[_head]; }
+        reference back() { return _buffer[index(_count - 1)]; }
+        const_reference back() const { return _buffer[index(_count - 1)]; }
+        /// Access by position from the oldest element.
+        reference operator[](size_type pos) { return _buffer[index(pos)]; }
+        const_reference operator[](size_type pos) const { return _buffer[index(pos)]; }
+        
+        // Capacity
+        bool empty() const { return (_count == 0); }
+        bool full() const { return (_count == N); }
+        size_type size() const { return _count; }
+        static size_type capacity() { return N; }
+        
+        // Modifiers
+        /// Append to the back.
+        /// @returns False if the buffer was full.
+        bool push_back(const T & value)
+        {
+            bool result = !full();
+            if (result)
+            {
+                _buffer[index(_count)] = value;
+                _count++;
+            }
+            return result;
+        }
+        
+        /// Append to the back, discarding the oldest element if full.
+        /// @returns False if an element was discarded.
+        bool push_back_overwrite(const T & value)
+        {
+            bool result = !full();
+            if (!result)
+            {
+                pop_front();
+            }
+            push_back(value);
+            return result;
+        }
+        
+        /// Remove from the front.
+        /// @returns False if the buffer was empty.
+        bool pop_front()
+        {
+            bool result = !empty();
+            if (result)
+            {
+                _head = index(1);
+                _count--;
+            }
+            return result;
+        }
+        
+        /// Copy the front element out and remove it.
+        /// @returns False if the buffer was empty.
+        bool pop_front(T & value)
+        {
+            bool result = !empty();
+            if (result)
+            {
+                value = front();
+                pop_front();
+            }
+            return result;
+        }
+        
+        void clear() { _head = 0; _count = 0; }
+        
+    private:
+        size_type index(size_type pos) const { return ((_head + pos) % N); }
+        
+        T _buffer[N];
+        size_type _head;
+        size_type _count;
+    };
+}
+
+#endif
@@ -0,0 +1,137 @@
+/******************************************************************//**
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+**********************************************************************/
+
+#ifndef OneWire_Temperature
+#define OneWire_Temperature
+
+#include <stdint.h>
+
+namespace OneWire
+{
+    /// Fixed-point temperature helpers for targets without an FPU.
+    /// Temperatures are int16_t in 1/16 degree units, the native format of
+    /// the DS18B20 temperature register.
+    namespace temperature
+    {
+        /// Number of fractional steps per degree.
+        static const int16_t sixteenthsPerDegree = 16;
+        
+        /// Divide rounding half away from zero.
+        inline int32_t roundedDivide(int32_t num, int32_t den)
+        {
+            return (num < 0) ? ((num - (den / 2)) / den) : ((num + (den / 2)) / den);
+        }
+        
+        /// Convert whole degrees to 1/16 degree units.
+        inline int16_t fromDegrees(int16_t degrees)
+        {
+            return static_cast<int16_t>(degrees * sixteenthsPerDegree);
+        }
+        
+        /// Whole degrees, truncated toward zero.
+        inline int16_t wholeDegrees(int16_t sixteenths)
+        {
+            return static_cast<int16_t>(sixteenths / sixteenthsPerDegree);
+        }
+        
+        /// Temperature in 1/10 degree units, for printing as "%d.%d".
+        inline int16_t tenths(int16_t sixteenths)
+        {
+            return static_cast<int16_t>(roundedDivide(static_cast<int32_t>(sixteenths) * 10, sixteenthsPerDegree));
+        }
+        
+        /// Largest magnitude in 1/10 degree units that fromTenths() can represent.
+        static const int16_t maxTenths = 20479;
+        
+        /// Convert 1/10 degree units to 1/16 degree units, for user input such as 36.5.
+        /// @param tenths Temperature within -maxTenths to maxTenths.
+        inline int16_t fromTenths(int16_t tenths)
+        {
+            return static_cast<int16_t>(roundedDivide(static_cast<int32_t>(tenths) * sixteenthsPerDegree, 10));
+        }
+        
+        /// Convert 1/16 degree Celsius to 1/16 degree Fahrenheit.
+        inline int16_t celsiusToFahrenheit(int16_t sixteenthsC)
+        {
+            return static_cast<int16_t>(roundedDivide(static_cast<int32_t>(sixteenthsC) * 9, 5) + (32 * sixteenthsPerDegree));
+        }
+        
+        /// Convert 1/16 degree Fahrenheit to 1/16 degree Celsius.
+        inline int16_t fahrenheitToCelsius(int16_t sixteenthsF)
+        {
+            return static_cast<int16_t>(roundedDivide((static_cast<int32_t>(sixteenthsF) - (32 * sixteenthsPerDegree)) * 5, 9));
+        }
+        
+        /// Result of comparing a temperature against a pair of thresholds.
+        enum ThresholdResult
+        {
+            BelowLow,
+            WithinLimits,
+            AboveHigh
+        };
+        
+        /// Compare a temperature against low and high thresholds.
+        /// @param sixteenths Temperature to compare.
+        /// @param low Lower threshold, inclusive.
+        /// @param high Upper threshold, inclusive.
+        inline ThresholdResult compareThresholds(int16_t sixteenths, int16_t low, int16_t high)
+        {
+            ThresholdResult result = WithinLimits;
+            
+            if (sixteenths < low)
+            {
+                result = BelowLow;
+            }
+            else if (sixteenths > high)
+            {
+                result = AboveHigh;
+            }
+            
+            return result;
+        }
+        
+        /// Check if a temperature lies strictly within band of a target.
+        inline bool withinBand(int16_t sixteenths, int16_t target, int16_t band)
+        {
+            int32_t diff = static_cast<int32_t>(sixteenths) - target;
+            return ((diff < band) && (diff > -band));
+        }
+        
+        /// Convert a DS18B20/DS1920 8-bit alarm threshold in whole degrees.
+        inline int16_t fromThreshold(uint8_t threshold)
+        {
+            return fromDegrees(static_cast<int8_t>(threshold));
+        }
+    }
+}
+
+#endif
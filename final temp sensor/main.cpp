@@ -1,6 +1,9 @@
 #include "mbed.h"
 #include <stdint.h>
 #include "DS18B20.h"
+#include "OneWire/Utilities/temperature.h"
+
+using namespace OneWire;
 
 DigitalInOut sensor(D8);     // sensor connected to pin D8
 DigitalOut green(D2);
@@ -9,8 +12,45 @@ DigitalOut red(D3);
 Ticker timer;                // used for our microsec timing
 Serial pc(D1, D0);     // serial comms back to console
 
-float FtoC(float f){
-    return (5 * (f - 32) / 9);
+// parse a decimal temperature such as "36.5" or "-4" into tenths of a degree,
+// rejecting anything temperature::fromTenths() cannot represent
+bool parseTenths(const char * s, int16_t & tenths){
+    bool negative = (*s == '-');
+    if(*s == '-' || *s == '+'){
+        s++;
+    }
+
+    int32_t value = 0;
+    bool digits = false;
+    while(*s >= '0' && *s <= '9'){
+        value = (value * 10) + (*s++ - '0');
+        digits = true;
+        if(value > (temperature::maxTenths / 10)){
+            return false;
+        }
+    }
+    value *= 10;
+
+    if(*s == '.'){
+        s++;
+        if(*s >= '0' && *s <= '9'){
+            value += (*s++ - '0');
+            digits = true;
+            // round on the hundredths digit, ignore the rest
+            if(*s >= '5' && *s <= '9'){
+                value++;
+            }
+            while(*s >= '0' && *s <= '9'){
+                s++;
+            }
+        }
+    }
+
+    if(!digits || *s != '\0' || value > temperature::maxTenths){
+        return false;
+    }
+    tenths = static_cast<int16_t>(negative ? -value : value);
+    return true;
 }
 
 int main() {
@@ -25,31 +65,37 @@ int main() {
     pc.printf("%c", c);
 
     pc.printf("\nEnter Desired Temperature:\t");
-    float r;
-    pc.scanf("%f", &r);
-    pc.printf("%f", r);
+    char input[16];
+    int16_t inputTenths;
+    pc.scanf("%15s", input);
+    pc.printf("%s", input);
+    while(!parseTenths(input, inputTenths)){
+        pc.printf("\nInvalid temperature, enter e.g. 36.5:\t");
+        pc.scanf("%15s", input);
+        pc.printf("%s", input);
+    }
 
+    // target in 1/16 degree C
+    int16_t r = temperature::fromTenths(inputTenths);
     if(c == 'F' || c == 'f'){//convert to celcius
-        r = FtoC(r);
+        r = temperature::fahrenheitToCelsius(r);
     }
      pc.printf("\n");
 
     while (1) {
-        uint32_t temp = GetTemperature();
-        float f = (temp & 0x0F) * 0.0625;    // calculate .4 part
-        f += (temp >> 4);
+        int16_t t = GetTemperature();    // 1/16 degree C
        
         displayTemperature(pc);
 
-        if(f > 47){
+        if(t > temperature::fromDegrees(47)){
             green = 0;
             red = 1;
         }
-        else if (int(f) == int(r)){
+        else if (temperature::wholeDegrees(t) == temperature::wholeDegrees(r)){
             green = 1;
             red = 0;
         }
-        else if ((f > r && f < r + 2.0) || (f < r && f > r - 2.0)){
+        else if (temperature::withinBand(t, r, temperature::fromDegrees(2))){
             green = 1;
             red = 1;
         }
@@ -58,6 +104,6 @@ int main() {
             red = 1;
         }
 
-        wait(.5);
+        wait_ms(500);
     }
 }